@@ -0,0 +1,173 @@
+#include "autotune.h"
+#include "solvers.h"
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace autotune
+{
+    constexpr int runsPerEngine{ 3 };
+
+    // Sample inputs for the given day, all inputs/dayNN_*.txt files except the puzzle examples, by ascending
+    // size. Examples are too small to tell engines apart & some solvers treat them differently.
+    std::vector<std::filesystem::path> sampleInputs(const int day)
+    {
+        const std::string prefix{ "day" + std::string(day < 10 ? "0" : "") + std::to_string(day) + "_" };
+        std::vector<std::filesystem::path> samples{};
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator{ "inputs", error })
+        {
+            const std::string fileName{ entry.path().filename().string() };
+            if (entry.is_regular_file() && fileName.starts_with(prefix) && fileName.ends_with(".txt") && !fileName.ends_with("_example.txt"))
+            {
+                samples.push_back(entry.path());
+            }
+        }
+
+        std::ranges::sort(samples, {}, [](const std::filesystem::path& path) { return std::filesystem::file_size(path); });
+        return samples;
+    }
+
+    // Best time out of a few runs, so a single slow run doesn't decide. Timing out, throwing or answering
+    // something else than the reference counts as infinitely slow.
+    long long timeEngine(const int day, const solvers::Engine& engine, const std::string& contents, const long long expectedAnswer)
+    {
+        long long bestMicroseconds{ std::numeric_limits<long long>::max() };
+        for (int run = 0; run < runsPerEngine; run++)
+        {
+            std::istringstream input{ contents };
+            solvers::SolveResult result{};
+            try
+            {
+                result = solvers::runEngine(day, engine.solve, input);
+            }
+            catch (const std::exception& e)
+            {
+                std::cout << "  engine " << engine.name << " failed: " << e.what() << '\n';
+                return std::numeric_limits<long long>::max();
+            }
+
+            if (result.timedOut)
+            {
+                return std::numeric_limits<long long>::max();
+            }
+
+            if (result.answer != expectedAnswer)
+            {
+                std::cout << "  engine " << engine.name << " answered " << result.answer << " instead of " << expectedAnswer << '\n';
+                return std::numeric_limits<long long>::max();
+            }
+
+            bestMicroseconds = std::min(result.microseconds, bestMicroseconds);
+        }
+
+        return bestMicroseconds;
+    }
+
+    // Answer of the reference engine, empty if it timed out or failed, as then no engine can be checked.
+    std::optional<long long> referenceAnswer(const int day, const solvers::Engine& reference, const std::string& contents)
+    {
+        std::istringstream input{ contents };
+        try
+        {
+            const solvers::SolveResult result{ solvers::runEngine(day, reference.solve, input) };
+            return result.timedOut ? std::nullopt : std::optional{ result.answer };
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+    }
+
+    // Times all engines of each day & part that has more than one on the sample inputs of that day, chooses
+    // the fastest engine giving the reference answer by input size & saves those choices to the engine config.
+    // Inputs larger than the largest sample use the engine that was fastest on it. Engines only meant for
+    // small inputs aren't considered, & samples the reference can't answer are skipped.
+    void run_autotune(const std::string& configFileName)
+    {
+        for (int day = 1; day <= 25; day++)
+        {
+            for (int part = 1; part <= 2; part++)
+            {
+                std::vector<solvers::Engine> engines{};
+                std::ranges::copy_if(solvers::getEngines(day, part), std::back_inserter(engines),
+                    [](const solvers::Engine& engine) { return !engine.smallInputsOnly; });
+                if (engines.size() < 2)
+                {
+                    continue;
+                }
+
+                const auto samples{ sampleInputs(day) };
+                if (samples.empty())
+                {
+                    std::cout << "Day " << day << " part " << part << ": no sample inputs, keeping current engine choice\n";
+                    continue;
+                }
+
+                std::vector<solvers::EngineChoice> choices{};
+                for (const auto& sample : samples)
+                {
+                    std::ifstream file{ sample, std::ios::binary };
+                    const std::string contents{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+
+                    const std::optional<long long> expectedAnswer{ referenceAnswer(day, engines.front(), contents) };
+                    if (!expectedAnswer)
+                    {
+                        std::cout << "Day " << day << " part " << part << ", " << sample.string() << ": reference gave no answer, skipped\n";
+                        continue;
+                    }
+
+                    size_t fastest{};
+                    long long fastestMicroseconds{ std::numeric_limits<long long>::max() };
+                    for (size_t i = 0; i < engines.size(); i++)
+                    {
+                        const long long microseconds{ timeEngine(day, engines[i], contents, *expectedAnswer) };
+                        if (microseconds < fastestMicroseconds)
+                        {
+                            fastest = i;
+                            fastestMicroseconds = microseconds;
+                        }
+                    }
+
+                    std::cout << "Day " << day << " part " << part << ", " << sample.string() << " (" << contents.size() << " bytes): "
+                        << engines[fastest].name << " fastest (" << fastestMicroseconds << " us)\n";
+
+                    if (!choices.empty() && choices.back().engine == engines[fastest].name)
+                    {
+                        choices.back().maxInputSize = contents.size();
+                    }
+                    else
+                    {
+                        choices.push_back(solvers::EngineChoice{ contents.size(), engines[fastest].name });
+                    }
+                }
+
+                if (choices.empty())
+                {
+                    std::cout << "Day " << day << " part " << part << ": no usable samples, keeping current engine choice\n";
+                    continue;
+                }
+
+                choices.back().maxInputSize = std::numeric_limits<size_t>::max();
+                solvers::setEngineChoices(day, part, choices);
+            }
+        }
+
+        if (!solvers::saveEngineConfig(configFileName))
+        {
+            std::cout << "Could not write engine config " << configFileName << '\n';
+            return;
+        }
+
+        std::cout << "Saved engine choices to " << configFileName << '\n';
+    }
+}
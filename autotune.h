@@ -0,0 +1,7 @@
+#pragma once
+#include <string>
+
+namespace autotune
+{
+    void run_autotune(const std::string& configFileName);
+}
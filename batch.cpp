@@ -0,0 +1,81 @@
+#include "batch.h"
+#include "loader.h"
+#include "scheduler.h"
+#include "solvers.h"
+
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace batch
+{
+    struct BatchResult
+    {
+        bool loaded{};
+        solvers::SolveResult result{};
+        std::string error{};
+    };
+
+    // Solves the given day & part for each of the input files. Files are solved on the scheduler as soon as
+    // the loader hands them over, and the answers are printed in the order the files were given.
+    // A solver failing or running out of its time budget on one file doesn't affect the others.
+    void run_batch(const int day, const int part, const std::vector<std::string>& fileNames)
+    {
+        if (!solvers::getSolver(day, part))
+        {
+            std::cout << "No solver for day " << day << " part " << part << '\n';
+            return;
+        }
+
+        std::vector<BatchResult> results(fileNames.size());
+        scheduler::TaskGroup solving{};
+        loader::loadFiles(fileNames, [&](loader::LoadedFile file)
+        {
+            if (!file.ok)
+            {
+                return;
+            }
+
+            solving.fork([&results, day, part, index = file.index, contents = std::move(file.contents)]
+            {
+                std::istringstream input{ contents };
+                try
+                {
+                    results[index] = BatchResult{ true, solvers::runTimed(day, part, input) };
+                }
+                catch (const std::exception& e)
+                {
+                    results[index] = BatchResult{ true, {}, e.what() };
+                }
+            });
+        });
+
+        solving.join();
+
+        for (size_t i = 0; i < fileNames.size(); i++)
+        {
+            if (!results[i].loaded)
+            {
+                std::cout << fileNames[i] << ": could not read file\n";
+                continue;
+            }
+
+            if (!results[i].error.empty())
+            {
+                std::cout << fileNames[i] << ": failed (" << results[i].error << ")\n";
+                continue;
+            }
+
+            if (results[i].result.timedOut)
+            {
+                std::cout << fileNames[i] << ": timed out after " << results[i].result.microseconds << " us ("
+                    << results[i].result.iterations << " iterations done)\n";
+                continue;
+            }
+
+            std::cout << fileNames[i] << ": " << results[i].result.answer << " (" << results[i].result.microseconds << " us)\n";
+        }
+    }
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace batch
+{
+    void run_batch(int day, int part, const std::vector<std::string>& fileNames);
+}
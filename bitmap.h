@@ -0,0 +1,161 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+// Packed visited-state lookup for grid searches: one bit per (x, y, state...) combination, where the extra
+// state dimensions are known at compile time (e.g. StateBitmap<4> for a direction per cell).
+// The bits of a cell are stored together, padded up to a power of two so a cell never straddles two words
+// unless it needs more than one word anyway.
+template <size_t... StateDims>
+class StateBitmap
+{
+public:
+    static constexpr size_t statesPerCell{ (size_t{ 1 } * ... * StateDims) };
+    static constexpr size_t cellStride{ std::bit_ceil(statesPerCell) };
+
+    StateBitmap(const size_t w, const size_t h) : width{ w }, height{ h }, words((w * h * cellStride + 63) / 64) {}
+
+    template <typename... State>
+    [[nodiscard]] bool test(const size_t x, const size_t y, const State... state) const
+    {
+        const size_t bit{ bitIndex(x, y, state...) };
+        return (words[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    template <typename... State>
+    void set(const size_t x, const size_t y, const State... state)
+    {
+        const size_t bit{ bitIndex(x, y, state...) };
+        words[bit / 64] |= std::uint64_t{ 1 } << (bit % 64);
+    }
+
+    // Sets the bit, returning whether it was already set before.
+    template <typename... State>
+    bool testAndSet(const size_t x, const size_t y, const State... state)
+    {
+        const size_t bit{ bitIndex(x, y, state...) };
+        const std::uint64_t mask{ std::uint64_t{ 1 } << (bit % 64) };
+        const bool wasSet{ (words[bit / 64] & mask) != 0 };
+        words[bit / 64] |= mask;
+        return wasSet;
+    }
+
+    void clear()
+    {
+        std::ranges::fill(words, std::uint64_t{});
+    }
+
+    [[nodiscard]] bool cellHasAnyState(const size_t x, const size_t y) const
+    {
+        const size_t firstBit{ (y * width + x) * cellStride };
+        if constexpr (cellStride <= 64)
+        {
+            return ((words[firstBit / 64] >> (firstBit % 64)) & cellMask()) != 0;
+        }
+        else
+        {
+            return std::any_of(words.begin() + static_cast<std::ptrdiff_t>(firstBit / 64),
+                words.begin() + static_cast<std::ptrdiff_t>((firstBit + cellStride) / 64),
+                [](const std::uint64_t word) { return word != 0; });
+        }
+    }
+
+    // Number of cells for which at least one state is set.
+    [[nodiscard]] size_t countCellsWithAnyState() const
+    {
+        if constexpr (cellStride <= 64)
+        {
+            // Fold each cell's bits down onto the lowest bit of that cell, then count those lowest bits.
+            size_t count{};
+            for (std::uint64_t word : words)
+            {
+                for (size_t shift = cellStride / 2; shift > 0; shift /= 2)
+                {
+                    word |= word >> shift;
+                }
+
+                count += static_cast<size_t>(std::popcount(word & lowestBitOfEachCell()));
+            }
+
+            return count;
+        }
+        else
+        {
+            size_t count{};
+            for (size_t y = 0; y < height; y++)
+            {
+                for (size_t x = 0; x < width; x++)
+                {
+                    count += cellHasAnyState(x, y) ? 1 : 0;
+                }
+            }
+
+            return count;
+        }
+    }
+
+    // Hints the cpu to start loading the bits of the given cell, for when we know it'll be tested soon.
+    void prefetch(const size_t x, const size_t y) const
+    {
+        const std::uint64_t* address{ &words[(y * width + x) * cellStride / 64] };
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+private:
+    size_t width;
+    size_t height;
+    std::vector<std::uint64_t> words;
+
+    // Row-major index of the state within a cell, i.e. the last state dimension varies fastest.
+    template <typename... State>
+    static constexpr size_t stateIndex(const State... state)
+    {
+        static_assert(sizeof...(State) == sizeof...(StateDims), "Need one index per state dimension");
+        constexpr std::array<size_t, sizeof...(StateDims) + 1> dims{ StateDims..., 1 };
+        const std::array<size_t, sizeof...(State) + 1> indices{ static_cast<size_t>(state)..., 0 };
+
+        size_t index{};
+        for (size_t i = 0; i < sizeof...(StateDims); i++)
+        {
+            index = index * dims[i] + indices[i];
+        }
+
+        return index;
+    }
+
+    template <typename... State>
+    [[nodiscard]] size_t bitIndex(const size_t x, const size_t y, const State... state) const
+    {
+        return (y * width + x) * cellStride + stateIndex(state...);
+    }
+
+    static constexpr std::uint64_t cellMask()
+    {
+        return cellStride == 64 ? ~std::uint64_t{} : (std::uint64_t{ 1 } << cellStride) - 1;
+    }
+
+    static constexpr std::uint64_t lowestBitOfEachCell()
+    {
+        std::uint64_t mask{};
+        for (size_t bit = 0; bit < 64; bit += cellStride)
+        {
+            mask |= std::uint64_t{ 1 } << bit;
+        }
+
+        return mask;
+    }
+};
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+namespace cancellation
+{
+    // Thrown out of a solver by checkpoint() once its token got cancelled or ran past its deadline.
+    class TimedOut : public std::runtime_error
+    {
+    public:
+        TimedOut(const long long elapsedMilliseconds, const long long iterations)
+            : std::runtime_error{ "timed out after " + std::to_string(elapsedMilliseconds) + " ms ("
+                + std::to_string(iterations) + " iterations done)" },
+            elapsedMs{ elapsedMilliseconds },
+            iterationsDone{ iterations }
+        {
+        }
+
+        long long elapsedMs;
+        long long iterationsDone;
+    };
+
+    // Cooperative cancellation for a single solve: long running loops call checkpoint(), which checks the
+    // token installed for the current thread every so many iterations.
+    class Token
+    {
+    public:
+        explicit Token(const std::chrono::steady_clock::duration budget)
+            : start{ std::chrono::steady_clock::now() }, deadline{ start + budget }
+        {
+        }
+
+        void cancel() { cancelled = true; }
+
+        // Counts the iterations since the last check & throws TimedOut if the solve should stop.
+        void check(const long long iterations)
+        {
+            const long long total{ iterationsDone += iterations };
+            const auto now{ std::chrono::steady_clock::now() };
+            if (cancelled || now >= deadline)
+            {
+                throw TimedOut{ std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count(), total };
+            }
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point deadline;
+        std::atomic<bool> cancelled{};
+        std::atomic<long long> iterationsDone{};
+    };
+
+    // Token of the solve running on this thread, if any. The scheduler carries it over to forked tasks.
+    inline thread_local Token* currentToken{};
+
+    // Iterations on this thread since the token was last checked, to keep reading the clock out of inner loops.
+    inline thread_local long long uncheckedIterations{};
+
+    constexpr long long iterationsPerCheck{ 1024 };
+
+    inline Token* current()
+    {
+        return currentToken;
+    }
+
+    // Call once per iteration of a loop that could run for a long time.
+    inline void checkpoint()
+    {
+        if (currentToken && ++uncheckedIterations >= iterationsPerCheck)
+        {
+            const long long iterations{ uncheckedIterations };
+            uncheckedIterations = 0;
+            currentToken->check(iterations);
+        }
+    }
+
+    // Installs the token as the current one of this thread while in scope.
+    class Scope
+    {
+    public:
+        explicit Scope(Token* token) : previous{ currentToken }
+        {
+            currentToken = token;
+        }
+
+        ~Scope()
+        {
+            currentToken = previous;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Token* previous;
+    };
+}
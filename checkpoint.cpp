@@ -0,0 +1,205 @@
+#include "checkpoint.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace checkpoint
+{
+    std::string checkpointDirectory{};
+
+    // Sets the directory checkpoints are kept in, checkpoints are disabled while it's empty.
+    void setDirectory(const std::string& directory)
+    {
+        checkpointDirectory = directory;
+    }
+
+    const std::string& directory()
+    {
+        return checkpointDirectory;
+    }
+
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& path, const Access access) : writable{ access == Access::readWrite }
+    {
+        file = writable
+            ? CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr)
+            : CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            file = nullptr;
+            return;
+        }
+
+        LARGE_INTEGER fileSize{};
+        GetFileSizeEx(file, &fileSize);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        opened = map();
+    }
+
+    MappedFile::~MappedFile()
+    {
+        unmap();
+        if (file)
+        {
+            CloseHandle(file);
+        }
+    }
+
+    bool MappedFile::resize(const size_t newSize)
+    {
+        if (!writable)
+        {
+            return false;
+        }
+
+        unmap();
+
+        LARGE_INTEGER distance{};
+        distance.QuadPart = static_cast<LONGLONG>(newSize);
+        if (!SetFilePointerEx(file, distance, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+        {
+            opened = false;
+            return false;
+        }
+
+        size = newSize;
+        opened = map();
+        return opened;
+    }
+
+    void MappedFile::flush() const
+    {
+        FlushViewOfFile(data, 0);
+    }
+
+    void MappedFile::sync() const
+    {
+        if (data)
+        {
+            FlushViewOfFile(data, 0);
+            FlushFileBuffers(file);
+        }
+    }
+
+    bool MappedFile::map()
+    {
+        if (size == 0)
+        {
+            return true;
+        }
+
+        mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            return false;
+        }
+
+        data = static_cast<std::byte*>(MapViewOfFile(mapping, writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, size));
+        return data != nullptr;
+    }
+
+    void MappedFile::unmap()
+    {
+        if (data)
+        {
+            UnmapViewOfFile(data);
+            data = nullptr;
+        }
+
+        if (mapping)
+        {
+            CloseHandle(mapping);
+            mapping = nullptr;
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string& path, const Access access) : writable{ access == Access::readWrite }
+    {
+        fd = writable ? open(path.c_str(), O_RDWR | O_CREAT, 0644) : open(path.c_str(), O_RDONLY);
+        struct stat status{};
+        if (fd < 0 || fstat(fd, &status) != 0)
+        {
+            return;
+        }
+
+        size = static_cast<size_t>(status.st_size);
+        opened = map();
+    }
+
+    MappedFile::~MappedFile()
+    {
+        unmap();
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+
+    bool MappedFile::resize(const size_t newSize)
+    {
+        if (!writable)
+        {
+            return false;
+        }
+
+        unmap();
+        if (ftruncate(fd, static_cast<off_t>(newSize)) != 0)
+        {
+            opened = false;
+            return false;
+        }
+
+        size = newSize;
+        opened = map();
+        return opened;
+    }
+
+    void MappedFile::flush() const
+    {
+        if (data)
+        {
+            msync(data, size, MS_ASYNC);
+        }
+    }
+
+    void MappedFile::sync() const
+    {
+        if (data)
+        {
+            msync(data, size, MS_SYNC);
+        }
+    }
+
+    bool MappedFile::map()
+    {
+        if (size == 0)
+        {
+            return true;
+        }
+
+        void* mapped{ mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0) };
+        if (mapped == MAP_FAILED)
+        {
+            return false;
+        }
+
+        data = static_cast<std::byte*>(mapped);
+        return true;
+    }
+
+    void MappedFile::unmap()
+    {
+        if (data)
+        {
+            munmap(data, size);
+            data = nullptr;
+        }
+    }
+#endif
+}
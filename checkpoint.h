@@ -0,0 +1,199 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace checkpoint
+{
+    void setDirectory(const std::string& directory);
+    const std::string& directory();
+
+    // FNV-1a hash, used to tie a checkpoint to the input it was made for.
+    constexpr std::uint64_t fingerprint(const std::string_view data, std::uint64_t hash = 14695981039346656037ull)
+    {
+        for (const char c : data)
+        {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // A file mapped into memory read/write, created if it doesn't exist yet. Opened read-only it must exist,
+    // can't be resized & its bytes must not be written to.
+    class MappedFile
+    {
+    public:
+        enum class Access
+        {
+            readWrite,
+            readOnly
+        };
+
+        explicit MappedFile(const std::string& path, Access access = Access::readWrite);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] bool ok() const { return opened; }
+        [[nodiscard]] std::span<std::byte> bytes() const { return { data, size }; }
+
+        // Grows or shrinks the file, remapping it. Previous spans are invalid afterwards.
+        bool resize(size_t newSize);
+
+        // Starts writing dirty pages back to disk without waiting for it.
+        void flush() const;
+
+        // Writes dirty pages back to disk, waiting for it. Orders writes to the file across a crash.
+        void sync() const;
+
+    private:
+#ifdef _WIN32
+        void* file{};
+        void* mapping{};
+#else
+        int fd{ -1 };
+#endif
+        bool opened{};
+        bool writable{};
+        std::byte* data{};
+        size_t size{};
+
+        bool map();
+        void unmap();
+    };
+
+    // Periodic checkpoint of a search, made of a fixed Header & a list of Records (both trivially copyable),
+    // stored in a memory-mapped file named after the solver & a fingerprint of its input.
+    // Does nothing unless a checkpoint directory was set.
+    template <typename Header, typename Record>
+    class Checkpoint
+    {
+        static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<Record>);
+
+        // Stored in front of the header. complete is cleared & synced to disk before the rest gets written,
+        // & only set again once that is synced too, so a checkpoint interrupted halfway through saving (even
+        // by a crash) is never resumed from.
+        struct FileHeader
+        {
+            std::uint64_t magic{};
+            std::uint64_t inputFingerprint{};
+            std::uint64_t headerSize{};
+            std::uint64_t recordSize{};
+            std::uint64_t recordCount{};
+            std::uint64_t complete{};
+        };
+
+        static constexpr std::uint64_t checkpointMagic{ 0x544e494f504b4843ull };
+
+    public:
+        Checkpoint(const std::string& name, const std::uint64_t inputFingerprint,
+            const std::chrono::steady_clock::duration saveInterval = std::chrono::seconds{ 1 })
+            : inputKey{ inputFingerprint }, interval{ saveInterval }, lastSave{ std::chrono::steady_clock::now() }
+        {
+            if (!directory().empty())
+            {
+                char fingerprintHex[17];
+                std::snprintf(fingerprintHex, sizeof(fingerprintHex), "%016llx", static_cast<unsigned long long>(inputFingerprint));
+                path = directory() + "/" + name + "_" + fingerprintHex + ".checkpoint";
+                file = std::make_unique<MappedFile>(path);
+            }
+        }
+
+        [[nodiscard]] bool enabled() const { return file && file->ok(); }
+
+        // Whether the save interval passed since the last save.
+        [[nodiscard]] bool due() const
+        {
+            return enabled() && std::chrono::steady_clock::now() - lastSave >= interval;
+        }
+
+        // Loads a complete checkpoint made for the same input, returns false if there is none.
+        bool load(Header& header, std::vector<Record>& records) const
+        {
+            if (!enabled() || file->bytes().size() < sizeof(FileHeader) + sizeof(Header))
+            {
+                return false;
+            }
+
+            FileHeader fileHeader;
+            std::memcpy(&fileHeader, file->bytes().data(), sizeof(FileHeader));
+            if (fileHeader.magic != checkpointMagic || fileHeader.inputFingerprint != inputKey || !fileHeader.complete
+                || fileHeader.headerSize != sizeof(Header) || fileHeader.recordSize != sizeof(Record)
+                || file->bytes().size() < fileSize(fileHeader.recordCount))
+            {
+                return false;
+            }
+
+            std::memcpy(&header, file->bytes().data() + sizeof(FileHeader), sizeof(Header));
+            records.resize(fileHeader.recordCount);
+            std::memcpy(records.data(), file->bytes().data() + sizeof(FileHeader) + sizeof(Header), records.size() * sizeof(Record));
+            return true;
+        }
+
+        void save(const Header& header, const std::span<const Record> records)
+        {
+            lastSave = std::chrono::steady_clock::now();
+            if (!enabled())
+            {
+                return;
+            }
+
+            if (file->bytes().size() != fileSize(records.size()) && !file->resize(fileSize(records.size())))
+            {
+                return;
+            }
+
+            std::byte* data{ file->bytes().data() };
+            storeComplete(data, 0);
+            file->sync();
+
+            const FileHeader fileHeader{ checkpointMagic, inputKey, sizeof(Header), sizeof(Record), records.size(), 0 };
+            std::memcpy(data, &fileHeader, offsetof(FileHeader, complete));
+            std::memcpy(data + sizeof(FileHeader), &header, sizeof(Header));
+            std::memcpy(data + sizeof(FileHeader) + sizeof(Header), records.data(), records.size_bytes());
+            file->sync();
+
+            storeComplete(data, 1);
+            file->flush();
+        }
+
+        // Removes the checkpoint once the search finished.
+        void remove()
+        {
+            if (enabled())
+            {
+                file.reset();
+                std::remove(path.c_str());
+            }
+        }
+
+    private:
+        std::uint64_t inputKey;
+        std::chrono::steady_clock::duration interval;
+        std::chrono::steady_clock::time_point lastSave;
+        std::string path{};
+        std::unique_ptr<MappedFile> file{};
+
+        // Through an atomic store, so the compiler can neither drop nor reorder it around the other writes.
+        static void storeComplete(std::byte* data, const std::uint64_t complete)
+        {
+            std::atomic_ref{ *reinterpret_cast<std::uint64_t*>(data + offsetof(FileHeader, complete)) }.store(complete, std::memory_order_release);
+        }
+
+        static size_t fileSize(const size_t recordCount)
+        {
+            return sizeof(FileHeader) + sizeof(Header) + recordCount * sizeof(Record);
+        }
+    };
+}
@@ -1,14 +1,34 @@
 #include "day01.h"
+#include "helpers.h"
+#include "scheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <fstream>
 #include <iostream>
 #include <regex>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DAY01_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace day01
 {
     int part1LineSum(const std::string& line);
     int part2LineSum(const std::string& line);
+    int automatonLineSum(std::string_view line);
+    long long chunkCalibrationSum(std::string_view chunk);
 
     void run_day(const bool example)
     {
@@ -17,6 +37,16 @@ namespace day01
         const std::string fileName{ example ? "inputs/day01_example.txt" : "inputs/day01_real.txt" };
         std::ifstream file{ fileName };
 
+        std::cout << "Part 1 answer: " << solvePart1(file) << '\n';
+
+        file.close();
+        file.open(fileName);
+
+        std::cout << "Part 2 answer: " << solvePart2(file) << '\n';
+    }
+
+    int solvePart1(std::istream& file)
+    {
         int sum{};
         std::string line;
         while (std::getline(file, line))
@@ -24,18 +54,67 @@ namespace day01
             sum += part1LineSum(line);
         }
 
-        std::cout << "Part 1 answer: " << sum << '\n';
+        return sum;
+    }
 
-        file.close();
-        file.open(fileName);
-        sum = 0;
+    int solvePart2(std::istream& file)
+    {
+        int sum{};
+        std::string line;
         while (std::getline(file, line))
         {
             sum += part2LineSum(line);
         }
 
+        return sum;
+    }
+
+    // Same as solvePart2, but decoding each line in a single pass over its characters using a digit automaton.
+    int solvePart2Automaton(std::istream& file)
+    {
+        const std::string input{ readAll(file) };
+        const std::string_view inputView{ input };
+
+        // Split lines the way std::getline does, so a trailing newline doesn't add an empty line.
+        int sum{};
+        size_t lineStart{};
+        while (lineStart < inputView.size())
+        {
+            size_t lineEnd{ inputView.find('\n', lineStart) };
+            if (lineEnd == std::string_view::npos)
+            {
+                lineEnd = inputView.size();
+            }
+
+            sum += automatonLineSum(inputView.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+        }
+
+        return sum;
+    }
+
+    // Same as solvePart1, but classifying 64 bytes at a time into digit & newline bit masks, with the
+    // input split into line aligned chunks that are summed in parallel.
+    long long solvePart1Simd(std::istream& file)
+    {
+        constexpr size_t chunkSize{ 1 << 20 };
+
+        const std::string input{ readAll(file) };
+        const std::string_view inputView{ input };
 
-        std::cout << "Part 2 answer: " << sum << '\n';
+        std::vector<std::string_view> chunks{};
+        size_t chunkStart{};
+        while (chunkStart < inputView.size())
+        {
+            size_t chunkEnd{ inputView.find('\n', std::min(chunkStart + chunkSize, inputView.size()) - 1) };
+            chunkEnd = chunkEnd == std::string_view::npos ? inputView.size() : chunkEnd + 1;
+            chunks.push_back(inputView.substr(chunkStart, chunkEnd - chunkStart));
+            chunkStart = chunkEnd;
+        }
+
+        return scheduler::parallel_reduce(0, chunks.size(), 0LL,
+            [&chunks](const size_t i) { return chunkCalibrationSum(chunks[i]); },
+            std::plus<long long>{});
     }
 
     int part1LineSum(const std::string& line)
@@ -105,4 +184,244 @@ namespace day01
 
         return firstDigit * 10 + secondDigit;
     }
+
+    // Aho-Corasick automaton over the digit words & the digits themselves, as a full transition table over
+    // all bytes so decoding is one table lookup per character. digit[state] is the digit matched when
+    // entering the state, or 0 if none.
+    struct DigitAutomaton
+    {
+        static constexpr size_t maxStates{ 64 };
+
+        std::array<std::array<std::uint8_t, 256>, maxStates> next{};
+        std::array<std::uint8_t, maxStates> digit{};
+    };
+
+    // Builds the automaton for the digit words as written, or reversed to scan lines from the back.
+    constexpr DigitAutomaton buildDigitAutomaton(const bool reversed)
+    {
+        constexpr std::array<std::string_view, 9> digitWords{ "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
+
+        DigitAutomaton automaton{};
+        std::uint8_t nrOfStates{ 1 };
+
+        // Trie of the words, where a transition to state 0 means there is no child yet.
+        for (std::uint8_t d = 1; d <= 9; d++)
+        {
+            const std::string_view word{ digitWords[d - 1] };
+            std::uint8_t state{};
+            for (size_t i = 0; i < word.size(); i++)
+            {
+                const auto c{ static_cast<unsigned char>(reversed ? word[word.size() - 1 - i] : word[i]) };
+                if (automaton.next[state][c] == 0)
+                {
+                    automaton.next[state][c] = nrOfStates++;
+                }
+
+                state = automaton.next[state][c];
+            }
+
+            automaton.digit[state] = d;
+        }
+
+        // Plain digits are single character words.
+        for (std::uint8_t d = 1; d <= 9; d++)
+        {
+            automaton.next[0]['0' + d] = nrOfStates;
+            automaton.digit[nrOfStates++] = d;
+        }
+
+        // Breadth first over the trie to set failure links, filling in missing transitions from the
+        // failure state (which is less deep, so already complete).
+        std::array<std::uint8_t, DigitAutomaton::maxStates> failure{};
+        std::array<std::uint8_t, DigitAutomaton::maxStates> queue{};
+        size_t queueStart{};
+        size_t queueEnd{};
+        for (const std::uint8_t child : automaton.next[0])
+        {
+            if (child != 0)
+            {
+                queue[queueEnd++] = child;
+            }
+        }
+
+        while (queueStart < queueEnd)
+        {
+            const std::uint8_t state{ queue[queueStart++] };
+            for (size_t c = 0; c < 256; c++)
+            {
+                const std::uint8_t child{ automaton.next[state][c] };
+                if (child == 0)
+                {
+                    automaton.next[state][c] = automaton.next[failure[state]][c];
+                    continue;
+                }
+
+                failure[child] = automaton.next[failure[state]][c];
+                if (automaton.digit[child] == 0)
+                {
+                    automaton.digit[child] = automaton.digit[failure[child]];
+                }
+
+                queue[queueEnd++] = child;
+            }
+        }
+
+        return automaton;
+    }
+
+    constexpr DigitAutomaton forwardDigitAutomaton{ buildDigitAutomaton(false) };
+    constexpr DigitAutomaton backwardDigitAutomaton{ buildDigitAutomaton(true) };
+
+    // First digit found scanning forward & last one found scanning backward. Since no digit word occurs
+    // inside another, the match ending last is also the one starting last.
+    int automatonLineSum(const std::string_view line)
+    {
+        int firstDigit{ -1 };
+        std::uint8_t state{};
+        for (const char c : line)
+        {
+            state = forwardDigitAutomaton.next[state][static_cast<unsigned char>(c)];
+            if (forwardDigitAutomaton.digit[state] != 0)
+            {
+                firstDigit = forwardDigitAutomaton.digit[state];
+                break;
+            }
+        }
+
+        int secondDigit{};
+        state = 0;
+        for (auto it = line.rbegin(); it != line.rend(); ++it)
+        {
+            state = backwardDigitAutomaton.next[state][static_cast<unsigned char>(*it)];
+            if (backwardDigitAutomaton.digit[state] != 0)
+            {
+                secondDigit = backwardDigitAutomaton.digit[state];
+                break;
+            }
+        }
+
+        return firstDigit * 10 + secondDigit;
+    }
+
+    // Bit i of digits/newlines is set if byte i of the block is a digit/newline.
+    struct BlockMasks
+    {
+        std::uint64_t digits{};
+        std::uint64_t newlines{};
+    };
+
+    BlockMasks classifyBlock(const char* block)
+    {
+#if defined(__AVX2__)
+        const __m256i zero{ _mm256_set1_epi8('0') };
+        const __m256i nine{ _mm256_set1_epi8(9) };
+        const __m256i newline{ _mm256_set1_epi8('\n') };
+
+        BlockMasks masks{};
+        for (int half = 0; half < 2; half++)
+        {
+            const __m256i bytes{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * half)) };
+            const __m256i offsets{ _mm256_sub_epi8(bytes, zero) };
+            const __m256i isDigit{ _mm256_cmpeq_epi8(_mm256_min_epu8(offsets, nine), offsets) };
+            const __m256i isNewline{ _mm256_cmpeq_epi8(bytes, newline) };
+            masks.digits |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(isDigit))) << (32 * half);
+            masks.newlines |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(isNewline))) << (32 * half);
+        }
+
+        return masks;
+#elif defined(DAY01_SSE2)
+        const __m128i zero{ _mm_set1_epi8('0') };
+        const __m128i nine{ _mm_set1_epi8(9) };
+        const __m128i newline{ _mm_set1_epi8('\n') };
+
+        BlockMasks masks{};
+        for (int quarter = 0; quarter < 4; quarter++)
+        {
+            const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * quarter)) };
+            const __m128i offsets{ _mm_sub_epi8(bytes, zero) };
+            const __m128i isDigit{ _mm_cmpeq_epi8(_mm_min_epu8(offsets, nine), offsets) };
+            const __m128i isNewline{ _mm_cmpeq_epi8(bytes, newline) };
+            masks.digits |= static_cast<std::uint64_t>(_mm_movemask_epi8(isDigit)) << (16 * quarter);
+            masks.newlines |= static_cast<std::uint64_t>(_mm_movemask_epi8(isNewline)) << (16 * quarter);
+        }
+
+        return masks;
+#else
+        BlockMasks masks{};
+        for (int i = 0; i < 64; i++)
+        {
+            const auto c{ static_cast<unsigned char>(block[i]) };
+            masks.digits |= static_cast<std::uint64_t>(c - '0' < 10u) << i;
+            masks.newlines |= static_cast<std::uint64_t>(c == '\n') << i;
+        }
+
+        return masks;
+#endif
+    }
+
+    // Sums the line values of a chunk of whole lines (the last one may lack its newline), picking the first &
+    // last digit of each line from the digit masks between consecutive newlines.
+    long long chunkCalibrationSum(const std::string_view chunk)
+    {
+        long long sum{};
+        int firstDigit{ -1 };
+        int secondDigit{};
+
+        const auto addDigits{ [&](const char* block, const std::uint64_t digits)
+        {
+            if (digits == 0)
+            {
+                return;
+            }
+
+            if (firstDigit < 0)
+            {
+                firstDigit = block[std::countr_zero(digits)] - '0';
+            }
+
+            secondDigit = block[63 - std::countl_zero(digits)] - '0';
+        } };
+
+        const auto processBlock{ [&](const char* block)
+        {
+            auto [digits, newlines] { classifyBlock(block) };
+            while (newlines != 0)
+            {
+                const int newlineIndex{ std::countr_zero(newlines) };
+                const std::uint64_t beforeNewline{ (std::uint64_t{ 1 } << newlineIndex) - 1 };
+                addDigits(block, digits & beforeNewline);
+
+                sum += firstDigit * 10 + secondDigit;
+                firstDigit = -1;
+                secondDigit = 0;
+
+                digits &= ~beforeNewline;
+                newlines &= newlines - 1;
+            }
+
+            addDigits(block, digits);
+        } };
+
+        size_t offset{};
+        for (; offset + 64 <= chunk.size(); offset += 64)
+        {
+            processBlock(chunk.data() + offset);
+        }
+
+        // Pad the tail with zero bytes, which are neither digits nor newlines.
+        if (offset < chunk.size())
+        {
+            std::array<char, 64> tail{};
+            std::memcpy(tail.data(), chunk.data() + offset, chunk.size() - offset);
+            processBlock(tail.data());
+        }
+
+        // Last line without a newline at the end of the input.
+        if (!chunk.empty() && chunk.back() != '\n')
+        {
+            sum += firstDigit * 10 + secondDigit;
+        }
+
+        return sum;
+    }
 }
@@ -1,5 +1,11 @@
 #pragma once
+#include <istream>
+
 namespace day01
 {
     void run_day(bool example);
+    int solvePart1(std::istream& file);
+    long long solvePart1Simd(std::istream& file);
+    int solvePart2(std::istream& file);
+    int solvePart2Automaton(std::istream& file);
 }
\ No newline at end of file
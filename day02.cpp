@@ -1,10 +1,20 @@
 #include "day02.h"
+#include "helpers.h"
+#include "scheduler.h"
 
+#include <algorithm>
+#include <array>
 #include <charconv>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <new>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace day02
 {
@@ -24,6 +34,14 @@ namespace day02
         const std::string fileName{ example ? "inputs/day02_example.txt" : "inputs/day02_real.txt" };
         std::ifstream file{ fileName };
 
+        const GameTotals totals{ summarizeGames(readAll(file)) };
+
+        std::cout << "Part 1 answer: " << totals.validIdSum << '\n';
+        std::cout << "Part 2 answer: " << totals.powerSum << '\n';
+    }
+
+    int solvePart1(std::istream& file)
+    {
         int sum{};
         int lineId{1};
         std::string line;
@@ -37,17 +55,505 @@ namespace day02
             lineId++;
         }
 
-        std::cout << "Part 1 answer: " << sum << '\n';
+        return sum;
+    }
 
-        file.close();
-        file.open(fileName);
-        sum = 0;
+    int solvePart2(std::istream& file)
+    {
+        int sum{};
+        std::string line;
         while (std::getline(file, line))
         {
             sum += part2LinePower(line);
         }
 
-        std::cout << "Part 2 answer: " << sum << '\n';
+        return sum;
+    }
+
+    int solvePart1Fused(std::istream& file)
+    {
+        return summarizeGames(readAll(file)).validIdSum;
+    }
+
+    int solvePart2Fused(std::istream& file)
+    {
+        return summarizeGames(readAll(file)).powerSum;
+    }
+
+    // Walks the line byte by byte: digits build up a count, & the first letter after a count names its colour.
+    // The letters of the rest of the colour word & all separators are skipped over.
+    GameMaxima parseGameMaxima(const std::string_view line)
+    {
+        GameMaxima maxima{};
+        int count{ -1 };
+        for (size_t i{ line.find(':') + 1 }; i < line.size(); i++)
+        {
+            const char c{ line[i] };
+            if (c >= '0' && c <= '9')
+            {
+                count = (count < 0 ? 0 : count * 10) + (c - '0');
+                continue;
+            }
+
+            if (count < 0 || c == ' ')
+            {
+                continue;
+            }
+
+            switch (c)
+            {
+            case 'r':
+                maxima.red = std::max(maxima.red, count);
+                break;
+            case 'g':
+                maxima.green = std::max(maxima.green, count);
+                break;
+            case 'b':
+                maxima.blue = std::max(maxima.blue, count);
+                break;
+            default:
+                throw std::runtime_error{ std::string{ "Found unexpected letter " } + c };
+            }
+
+            count = -1;
+        }
+
+        return maxima;
+    }
+
+    // Games are numbered by line, lines split the way std::getline does.
+    GameTotals summarizeGames(const std::string_view input)
+    {
+        GameTotals totals{};
+        int lineId{ 1 };
+        size_t lineStart{};
+        while (lineStart < input.size())
+        {
+            size_t lineEnd{ input.find('\n', lineStart) };
+            if (lineEnd == std::string_view::npos)
+            {
+                lineEnd = input.size();
+            }
+
+            const GameMaxima maxima{ parseGameMaxima(input.substr(lineStart, lineEnd - lineStart)) };
+            if (maxima.red <= maxRed && maxima.green <= maxGreen && maxima.blue <= maxBlue)
+            {
+                totals.validIdSum += lineId;
+            }
+
+            totals.powerSum += maxima.red * maxima.green * maxima.blue;
+            lineId++;
+            lineStart = lineEnd + 1;
+        }
+
+        return totals;
+    }
+
+    // Maxima of each game, the game with ID i at index i - 1.
+    std::vector<GameMaxima> parseGames(const std::string_view input)
+    {
+        std::vector<GameMaxima> games{};
+        size_t lineStart{};
+        while (lineStart < input.size())
+        {
+            size_t lineEnd{ input.find('\n', lineStart) };
+            if (lineEnd == std::string_view::npos)
+            {
+                lineEnd = input.size();
+            }
+
+            games.push_back(parseGameMaxima(input.substr(lineStart, lineEnd - lineStart)));
+            lineStart = lineEnd + 1;
+        }
+
+        return games;
+    }
+
+    long long solvePart1Indexed(std::istream& file)
+    {
+        return BagLimitIndex{ readAll(file) }.feasibleIdSum({ maxRed, maxGreen, maxBlue });
+    }
+
+    // Answers each "red green blue" line of the queries file against the games of the log file.
+    void run_bag_limits(const std::string& logFileName, const std::string& queriesFileName)
+    {
+        std::ifstream logFile{ logFileName };
+        std::ifstream queriesFile{ queriesFileName };
+        if (!logFile || !queriesFile)
+        {
+            std::cout << (logFile ? queriesFileName : logFileName) << ": could not read file\n";
+            return;
+        }
+
+        const BagLimitIndex index{ readAll(logFile) };
+
+        std::vector<BagLimits> queries{};
+        BagLimits limits{};
+        while (queriesFile >> limits.red >> limits.green >> limits.blue)
+        {
+            queries.push_back(limits);
+        }
+
+        const std::vector<long long> idSums{ index.feasibleIdSums(queries) };
+        for (size_t i = 0; i < queries.size(); i++)
+        {
+            std::cout << queries[i].red << ' ' << queries[i].green << ' ' << queries[i].blue << ": " << idSums[i] << '\n';
+        }
+    }
+
+    long long solvePart1Columnar(std::istream& file)
+    {
+        return GameColumns{ readAll(file) }.feasibleIdSum({ maxRed, maxGreen, maxBlue });
+    }
+
+    long long solvePart2Columnar(std::istream& file)
+    {
+        return GameColumns{ readAll(file) }.powerSum();
+    }
+
+    // Parses a game log once into a columnar store file, for run_columns to answer from.
+    void run_save_columns(const std::string& logFileName, const std::string& columnsFileName)
+    {
+        std::ifstream logFile{ logFileName };
+        if (!logFile)
+        {
+            std::cout << logFileName << ": could not read file\n";
+            return;
+        }
+
+        const GameColumns columns{ readAll(logFile) };
+        if (!columns.save(columnsFileName))
+        {
+            std::cout << columnsFileName << ": could not write file\n";
+            return;
+        }
+
+        std::cout << "Saved " << columns.size() << " games to " << columnsFileName << '\n';
+    }
+
+    void run_columns(const std::string& columnsFileName)
+    {
+        if (!std::ifstream{ columnsFileName })
+        {
+            std::cout << columnsFileName << ": could not read file\n";
+            return;
+        }
+
+        const std::optional<GameColumns> columns{ GameColumns::load(columnsFileName) };
+        if (!columns)
+        {
+            std::cout << columnsFileName << ": not a game columns file\n";
+            return;
+        }
+
+        std::cout << "Part 1 answer: " << columns->feasibleIdSum({ maxRed, maxGreen, maxBlue }) << '\n';
+        std::cout << "Part 2 answer: " << columns->powerSum() << '\n';
+    }
+
+    constexpr std::uint64_t tailMagic{ 0x4c494154324e5552ull };
+
+    // Folds the complete lines appended to the log into the state, leaving an unfinished last line (the writer
+    // may still be busy with it) for the next run. Returns the number of games folded in.
+    size_t foldNewGames(const std::string_view appended, TailState& state)
+    {
+        size_t games{};
+        size_t lineStart{};
+        size_t lineEnd;
+        while ((lineEnd = appended.find('\n', lineStart)) != std::string_view::npos)
+        {
+            const GameMaxima maxima{ parseGameMaxima(appended.substr(lineStart, lineEnd - lineStart)) };
+            if (maxima.red <= maxRed && maxima.green <= maxGreen && maxima.blue <= maxBlue)
+            {
+                state.validIdSum += static_cast<std::int64_t>(state.nextId);
+            }
+
+            state.powerSum += static_cast<std::int64_t>(maxima.red) * maxima.green * maxima.blue;
+            state.nextId++;
+            state.lastLineOffset = state.offset + lineStart;
+            state.lastLineFingerprint = checkpoint::fingerprint(appended.substr(lineStart, lineEnd + 1 - lineStart));
+            games++;
+            lineStart = lineEnd + 1;
+        }
+
+        state.offset += lineStart;
+        return games;
+    }
+
+    // Whether the log still holds the lines the state was made from, by checking the last one folded in.
+    bool tailMatchesLog(std::istream& log, const TailState& state)
+    {
+        if (state.offset == 0)
+        {
+            return true;
+        }
+
+        std::string lastLine(static_cast<size_t>(state.offset - state.lastLineOffset), '\0');
+        log.seekg(static_cast<std::streamoff>(state.lastLineOffset));
+        return log.read(lastLine.data(), static_cast<std::streamsize>(lastLine.size()))
+            && checkpoint::fingerprint(lastLine) == state.lastLineFingerprint;
+    }
+
+    // Updates the answers of a growing log with the lines appended since the previous run, starting over if
+    // the log was truncated or rewritten.
+    void run_tail(const std::string& logFileName)
+    {
+        std::ifstream log{ logFileName, std::ios::binary };
+        if (!log)
+        {
+            std::cout << logFileName << ": could not read file\n";
+            return;
+        }
+
+        const std::string stateFileName{ logFileName + ".tail" };
+        TailState state{};
+        std::ifstream stateFile{ stateFileName, std::ios::binary };
+        if (!stateFile.read(reinterpret_cast<char*>(&state), sizeof(state)) || state.magic != tailMagic || !tailMatchesLog(log, state))
+        {
+            state = TailState{ tailMagic };
+        }
+
+        stateFile.close();
+
+        log.clear();
+        log.seekg(static_cast<std::streamoff>(state.offset));
+        const std::string appended{ readAll(log) };
+        const size_t games{ foldNewGames(appended, state) };
+
+        std::ofstream{ stateFileName, std::ios::binary | std::ios::trunc }.write(reinterpret_cast<const char*>(&state), sizeof(state));
+
+        std::cout << "Folded in " << games << " new games (" << appended.size() << " bytes read)\n";
+        std::cout << "Part 1 answer: " << state.validIdSum << '\n';
+        std::cout << "Part 2 answer: " << state.powerSum << '\n';
+    }
+
+    constexpr size_t columnAlignment{ 64 };
+    constexpr std::uint64_t columnsMagic{ 0x534e4d554c4f4332ull };
+
+    // Start of a store, padded to the column alignment.
+    struct ColumnsHeader
+    {
+        std::uint64_t magic{};
+        std::uint64_t gameCount{};
+    };
+
+    constexpr size_t alignColumn(const size_t size)
+    {
+        return (size + columnAlignment - 1) / columnAlignment * columnAlignment;
+    }
+
+    // Offset of the given column, or the size of the whole store for the column after the last one.
+    size_t GameColumns::columnOffset(const size_t gameCount, const int column)
+    {
+        const size_t colourColumnSize{ alignColumn(gameCount * sizeof(std::uint16_t)) };
+        const size_t offset{ alignColumn(sizeof(ColumnsHeader)) + static_cast<size_t>(std::min(column, 3)) * colourColumnSize };
+        return column < 4 ? offset : offset + alignColumn(gameCount * sizeof(std::uint32_t));
+    }
+
+    void GameColumns::AlignedDelete::operator()(std::byte* data) const
+    {
+        ::operator delete[](data, std::align_val_t{ columnAlignment });
+    }
+
+    GameColumns::GameColumns(const std::string_view input)
+    {
+        const std::vector<GameMaxima> games{ parseGames(input) };
+        gameCount = games.size();
+
+        const size_t storeSize{ columnOffset(gameCount, 4) };
+        buffer.reset(static_cast<std::byte*>(::operator new[](storeSize, std::align_val_t{ columnAlignment })));
+        bytes = { buffer.get(), storeSize };
+        std::memset(bytes.data(), 0, bytes.size());
+
+        const ColumnsHeader header{ columnsMagic, gameCount };
+        std::memcpy(bytes.data(), &header, sizeof(header));
+
+        auto* red{ reinterpret_cast<std::uint16_t*>(bytes.data() + columnOffset(gameCount, 0)) };
+        auto* green{ reinterpret_cast<std::uint16_t*>(bytes.data() + columnOffset(gameCount, 1)) };
+        auto* blue{ reinterpret_cast<std::uint16_t*>(bytes.data() + columnOffset(gameCount, 2)) };
+        auto* id{ reinterpret_cast<std::uint32_t*>(bytes.data() + columnOffset(gameCount, 3)) };
+        for (size_t i = 0; i < gameCount; i++)
+        {
+            const GameMaxima& game{ games[i] };
+            if (std::max({ game.red, game.green, game.blue }) > std::numeric_limits<std::uint16_t>::max())
+            {
+                throw std::out_of_range{ "Game " + std::to_string(i + 1) + " reveals too many cubes for the columnar store" };
+            }
+
+            red[i] = static_cast<std::uint16_t>(game.red);
+            green[i] = static_cast<std::uint16_t>(game.green);
+            blue[i] = static_cast<std::uint16_t>(game.blue);
+            id[i] = static_cast<std::uint32_t>(i + 1);
+        }
+    }
+
+    std::optional<GameColumns> GameColumns::load(const std::string& fileName)
+    {
+        GameColumns columns{};
+        columns.file = std::make_unique<checkpoint::MappedFile>(fileName, checkpoint::MappedFile::Access::readOnly);
+        const std::span<std::byte> fileBytes{ columns.file->bytes() };
+        if (!columns.file->ok() || fileBytes.size() < sizeof(ColumnsHeader))
+        {
+            return std::nullopt;
+        }
+
+        ColumnsHeader header;
+        std::memcpy(&header, fileBytes.data(), sizeof(header));
+        if (header.magic != columnsMagic || fileBytes.size() != columnOffset(header.gameCount, 4))
+        {
+            return std::nullopt;
+        }
+
+        columns.gameCount = header.gameCount;
+        columns.bytes = fileBytes;
+        return columns;
+    }
+
+    bool GameColumns::save(const std::string& fileName) const
+    {
+        checkpoint::MappedFile saved{ fileName };
+        if (!saved.ok() || !saved.resize(bytes.size()))
+        {
+            return false;
+        }
+
+        std::memcpy(saved.bytes().data(), bytes.data(), bytes.size());
+        saved.flush();
+        return true;
+    }
+
+    // Branch free, so the compiler turns it into packed compares & masked adds.
+    long long GameColumns::feasibleIdSum(const BagLimits& limits) const
+    {
+        if (std::min({ limits.red, limits.green, limits.blue }) < 0)
+        {
+            return 0;
+        }
+
+        constexpr int maxCount{ std::numeric_limits<std::uint16_t>::max() };
+        const std::uint16_t maxRedCount{ static_cast<std::uint16_t>(std::min(limits.red, maxCount)) };
+        const std::uint16_t maxGreenCount{ static_cast<std::uint16_t>(std::min(limits.green, maxCount)) };
+        const std::uint16_t maxBlueCount{ static_cast<std::uint16_t>(std::min(limits.blue, maxCount)) };
+
+        const std::uint16_t* red{ reds().data() };
+        const std::uint16_t* green{ greens().data() };
+        const std::uint16_t* blue{ blues().data() };
+        const std::uint32_t* id{ ids().data() };
+
+        std::uint64_t idSum{};
+        for (size_t i = 0; i < gameCount; i++)
+        {
+            const std::uint32_t fits{ static_cast<std::uint32_t>((red[i] <= maxRedCount) & (green[i] <= maxGreenCount) & (blue[i] <= maxBlueCount)) };
+            idSum += id[i] & (0u - fits);
+        }
+
+        return static_cast<long long>(idSum);
+    }
+
+    long long GameColumns::powerSum() const
+    {
+        const std::uint16_t* red{ reds().data() };
+        const std::uint16_t* green{ greens().data() };
+        const std::uint16_t* blue{ blues().data() };
+
+        std::uint64_t sum{};
+        for (size_t i = 0; i < gameCount; i++)
+        {
+            sum += static_cast<std::uint64_t>(static_cast<std::uint32_t>(red[i]) * green[i]) * blue[i];
+        }
+
+        return static_cast<long long>(sum);
+    }
+
+    BagLimitIndex::BagLimitIndex(const std::string_view input)
+    {
+        constexpr size_t maxTableSize{ 1 << 22 };
+
+        std::vector<GameMaxima> parsedGames{ parseGames(input) };
+        for (const GameMaxima& game : parsedGames)
+        {
+            reds.push_back(game.red);
+            greens.push_back(game.green);
+            blues.push_back(game.blue);
+        }
+
+        for (std::vector<int>* values : { &reds, &greens, &blues })
+        {
+            std::ranges::sort(*values);
+            values->erase(std::ranges::unique(*values).begin(), values->end());
+        }
+
+        if (reds.size() * greens.size() * blues.size() > maxTableSize)
+        {
+            games = std::move(parsedGames);
+            return;
+        }
+
+        const auto rank = [](const std::vector<int>& values, const int value)
+            {
+                return static_cast<size_t>(std::ranges::lower_bound(values, value) - values.begin());
+            };
+
+        const size_t redStride{ greens.size() * blues.size() };
+        const size_t greenStride{ blues.size() };
+        idSums.resize(reds.size() * redStride);
+        for (size_t i = 0; i < parsedGames.size(); i++)
+        {
+            const GameMaxima& game{ parsedGames[i] };
+            idSums[rank(reds, game.red) * redStride + rank(greens, game.green) * greenStride + rank(blues, game.blue)] += static_cast<long long>(i + 1);
+        }
+
+        // Prefix sums along each colour in turn, after which each cell holds the sum over all cells it dominates.
+        const std::array<std::pair<size_t, size_t>, 3> axes{ { { 1, blues.size() }, { greenStride, greens.size() }, { redStride, reds.size() } } };
+        for (const auto& [stride, axisSize] : axes)
+        {
+            for (size_t cell = 0; cell < idSums.size(); cell++)
+            {
+                if (cell / stride % axisSize > 0)
+                {
+                    idSums[cell] += idSums[cell - stride];
+                }
+            }
+        }
+    }
+
+    long long BagLimitIndex::feasibleIdSum(const BagLimits& limits) const
+    {
+        if (!games.empty())
+        {
+            long long idSum{};
+            for (size_t i = 0; i < games.size(); i++)
+            {
+                if (games[i].red <= limits.red && games[i].green <= limits.green && games[i].blue <= limits.blue)
+                {
+                    idSum += static_cast<long long>(i + 1);
+                }
+            }
+
+            return idSum;
+        }
+
+        // Number of distinct maxima of each colour within the limit, the cell of the largest one holds the answer.
+        const auto withinLimit = [](const std::vector<int>& values, const int limit)
+            {
+                return static_cast<size_t>(std::ranges::upper_bound(values, limit) - values.begin());
+            };
+
+        const size_t red{ withinLimit(reds, limits.red) };
+        const size_t green{ withinLimit(greens, limits.green) };
+        const size_t blue{ withinLimit(blues, limits.blue) };
+        if (red == 0 || green == 0 || blue == 0)
+        {
+            return 0;
+        }
+
+        return idSums[((red - 1) * greens.size() + green - 1) * blues.size() + blue - 1];
+    }
+
+    std::vector<long long> BagLimitIndex::feasibleIdSums(const std::span<const BagLimits> queries) const
+    {
+        std::vector<long long> idSums(queries.size());
+        scheduler::parallel_for(0, queries.size(), [&](const size_t i) { idSums[i] = feasibleIdSum(queries[i]); }, 4096);
+        return idSums;
     }
 
     bool singleColorRevealFits(std::string_view colorReveal)
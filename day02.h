@@ -1,5 +1,137 @@
 #pragma once
+#include "checkpoint.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace day02
 {
     void run_day(bool example);
+    int solvePart1(std::istream& file);
+    int solvePart2(std::istream& file);
+
+    // Largest number of cubes of each colour revealed during one game.
+    struct GameMaxima
+    {
+        int red{};
+        int green{};
+        int blue{};
+    };
+
+    // Both answers, derived from the per-game maxima in a single pass over the input.
+    struct GameTotals
+    {
+        int validIdSum{};
+        int powerSum{};
+    };
+
+    // Bag content to test the games against.
+    struct BagLimits
+    {
+        int red{};
+        int green{};
+        int blue{};
+    };
+
+    // Answers the sum of the IDs of the games possible with any given bag, after parsing the log once.
+    // Holds the ID sum of the games dominated by each combination of distinct per-colour maxima, so a query
+    // is three binary searches & a lookup.
+    class BagLimitIndex
+    {
+    public:
+        explicit BagLimitIndex(std::string_view input);
+
+        [[nodiscard]] long long feasibleIdSum(const BagLimits& limits) const;
+        [[nodiscard]] std::vector<long long> feasibleIdSums(std::span<const BagLimits> queries) const;
+
+    private:
+        std::vector<int> reds{};
+        std::vector<int> greens{};
+        std::vector<int> blues{};
+        std::vector<long long> idSums{};
+
+        // Kept instead of the table when that would get too large, queries scan all games then.
+        std::vector<GameMaxima> games{};
+    };
+
+    // Per-game colour maxima stored column by column, so the validity & power passes vectorise. Laid out the
+    // same in memory & on disk (a header, then the red, green, blue & ID columns, each 64 byte aligned), so a
+    // saved store is used straight from its memory-mapped file without parsing any text.
+    class GameColumns
+    {
+    public:
+        explicit GameColumns(std::string_view input);
+
+        // Maps a store saved earlier read-only, empty if the file is missing or not a store.
+        static std::optional<GameColumns> load(const std::string& fileName);
+        bool save(const std::string& fileName) const;
+
+        [[nodiscard]] size_t size() const { return gameCount; }
+        [[nodiscard]] std::span<const std::uint16_t> reds() const { return column<std::uint16_t>(0); }
+        [[nodiscard]] std::span<const std::uint16_t> greens() const { return column<std::uint16_t>(1); }
+        [[nodiscard]] std::span<const std::uint16_t> blues() const { return column<std::uint16_t>(2); }
+        [[nodiscard]] std::span<const std::uint32_t> ids() const { return column<std::uint32_t>(3); }
+
+        [[nodiscard]] long long feasibleIdSum(const BagLimits& limits) const;
+        [[nodiscard]] long long powerSum() const;
+
+    private:
+        struct AlignedDelete
+        {
+            void operator()(std::byte* data) const;
+        };
+
+        GameColumns() = default;
+
+        static size_t columnOffset(size_t gameCount, int column);
+
+        template <typename T>
+        std::span<const T> column(const int index) const
+        {
+            return { reinterpret_cast<const T*>(bytes.data() + columnOffset(gameCount, index)), gameCount };
+        }
+
+        size_t gameCount{};
+        std::span<std::byte> bytes{};
+
+        // Owner of bytes, either parsed into memory or a mapped file.
+        std::unique_ptr<std::byte[], AlignedDelete> buffer{};
+        std::unique_ptr<checkpoint::MappedFile> file{};
+    };
+
+    // Running answers of a growing game log, up to the end of the last complete line folded in. Stored next to
+    // the log, so each run of the tail mode only parses the lines appended since the previous one.
+    struct TailState
+    {
+        std::uint64_t magic{};
+        std::uint64_t offset{};
+        std::uint64_t nextId{ 1 };
+        std::int64_t validIdSum{};
+        std::int64_t powerSum{};
+
+        // Where the last line folded in starts & its fingerprint, to notice the log was rewritten in between.
+        std::uint64_t lastLineOffset{};
+        std::uint64_t lastLineFingerprint{};
+    };
+
+    GameMaxima parseGameMaxima(std::string_view line);
+    std::vector<GameMaxima> parseGames(std::string_view input);
+    GameTotals summarizeGames(std::string_view input);
+    int solvePart1Fused(std::istream& file);
+    int solvePart2Fused(std::istream& file);
+    long long solvePart1Indexed(std::istream& file);
+    long long solvePart1Columnar(std::istream& file);
+    long long solvePart2Columnar(std::istream& file);
+    void run_save_columns(const std::string& logFileName, const std::string& columnsFileName);
+    void run_columns(const std::string& columnsFileName);
+    size_t foldNewGames(std::string_view appended, TailState& state);
+    void run_tail(const std::string& logFileName);
+    void run_bag_limits(const std::string& logFileName, const std::string& queriesFileName);
 }
\ No newline at end of file
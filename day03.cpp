@@ -1,16 +1,24 @@
 #include "day03.h"
+#include "helpers.h"
+#include "scheduler.h"
 
+#include <algorithm>
+#include <bit>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace day03
 {
-    int solvePart1(std::ifstream& file);
-    int solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 03 \n";
@@ -29,7 +37,7 @@ namespace day03
         std::cout << "Part 2 answer: " << sum << '\n';
     }
 
-    std::vector<std::vector<char>> parseInput(std::ifstream& file)
+    std::vector<std::vector<char>> parseInput(std::istream& file)
     {
         // For height loop over lines and count:
         size_t height{};
@@ -58,7 +66,7 @@ namespace day03
         return field;
     }
 
-    int solvePart1(std::ifstream& file)
+    int solvePart1(std::istream& file)
     {
         const std::vector<std::vector<char>> field{ parseInput(file) };
         const int height{ static_cast<int>(field.size()) };
@@ -88,15 +96,19 @@ namespace day03
                     x++;
                 }
 
+                // Reached the end of the line without finding another number.
+                if (x == startOfNumber)
+                    continue;
+
                 const size_t endOfNumber{ x - 1 };
 
-                // Now need to determine if number is partConnected
+                // Now need to determine if number is partConnected, the neighbourhood clamped to the field
                 bool partAdjacent{};
-                for (size_t compareY = y - 1; compareY <= y + 1; compareY++)
+                for (size_t compareY = (y > 0 ? y - 1 : 0); compareY <= y + 1; compareY++)
                 {
-                    for (size_t compareX = startOfNumber - 1; compareX <= endOfNumber + 1; compareX++)
+                    for (size_t compareX = (startOfNumber > 0 ? startOfNumber - 1 : 0); compareX <= endOfNumber + 1; compareX++)
                     {
-                        if (compareY > 0 && compareY < height && compareX > 0 && compareX < width
+                        if (compareY < height && compareX < width
                             && !std::isdigit(field[compareY][compareX]) && field[compareY][compareX] != '.')
                             // Found an adjacent square in field with non-digit, non-. character
                             partAdjacent = true;
@@ -111,7 +123,7 @@ namespace day03
         return partsSum;
     }
 
-    int solvePart2(std::ifstream& file)
+    int solvePart2(std::istream& file)
     {
         const std::vector<std::vector<char>> field{ parseInput(file) };
         const size_t height{ (field.size()) };
@@ -145,14 +157,18 @@ namespace day03
                     x++;
                 }
 
+                // Reached the end of the line without finding another number.
+                if (x == startOfNumber)
+                    continue;
+
                 const size_t endOfNumber{ x - 1 };
 
-                // Now check for adjacent gears to up our count/product field for
-                for (size_t compareY = y - 1; compareY <= y + 1; compareY++)
+                // Now check for adjacent gears to up our count/product field for, clamped to the field
+                for (size_t compareY = (y > 0 ? y - 1 : 0); compareY <= y + 1; compareY++)
                 {
-                    for (size_t compareX = startOfNumber - 1; compareX <= endOfNumber + 1; compareX++)
+                    for (size_t compareX = (startOfNumber > 0 ? startOfNumber - 1 : 0); compareX <= endOfNumber + 1; compareX++)
                     {
-                        if (compareY > 0 && compareY < height && compareX > 0 && compareX < width
+                        if (compareY < height && compareX < width
                             && field[compareY][compareX] == '*')
                         {
                             // Found an adjacent square in field with gear in it, up count & product.
@@ -177,4 +193,549 @@ namespace day03
 
         return faultySum;
     }
-}
\ No newline at end of file
+
+    int solvePart1SinglePass(std::istream& file)
+    {
+        return summarizeSchematic(parsePaddedGrid(readAll(file))).partSum;
+    }
+
+    int solvePart2SinglePass(std::istream& file)
+    {
+        return summarizeSchematic(parsePaddedGrid(readAll(file))).gearRatioSum;
+    }
+
+    int solvePart1Banded(std::istream& file)
+    {
+        return summarizeBanded(file).partSum;
+    }
+
+    int solvePart2Banded(std::istream& file)
+    {
+        return summarizeBanded(file).gearRatioSum;
+    }
+
+    // Bands of two rows, read three bands at a time, so even small inputs cross band & batch boundaries. Only
+    // worth it to check those boundaries.
+    constexpr size_t narrowBandRows{ 2 };
+    constexpr size_t narrowBatchBands{ 3 };
+
+    int solvePart1BandedNarrow(std::istream& file)
+    {
+        return summarizeBanded(file, narrowBandRows, narrowBatchBands).partSum;
+    }
+
+    int solvePart2BandedNarrow(std::istream& file)
+    {
+        return summarizeBanded(file, narrowBandRows, narrowBatchBands).gearRatioSum;
+    }
+
+    // Streams the schematic a batch of rows at a time, solving the bands of each batch in parallel. A band gets
+    // the row above & below it as halo, so numbers & gears at its edges see their neighbours, but only counts
+    // the numbers & gears of its own rows, so the ones next to a band boundary are counted exactly once.
+    // Batches of a few bands per worker are read at a time, which bounds the rows kept in memory, unless a batch
+    // size is given.
+    SchematicTotals summarizeBanded(std::istream& file, const size_t bandRows, const size_t batchBands)
+    {
+        if (bandRows == 0)
+        {
+            throw std::out_of_range("Bands need at least one row");
+        }
+
+        const size_t batchRows{ bandRows * (batchBands > 0 ? batchBands
+            : 4 * std::max<size_t>(scheduler::defaultScheduler().workerCount(), 1)) };
+
+        // The last row of the previous batch as halo (once there is one), the rows of this batch & the first
+        // row of the next batch as halo.
+        std::vector<std::string> rows{};
+        size_t firstRow{};
+
+        SchematicTotals totals{};
+        std::string line;
+        while (true)
+        {
+            while (rows.size() < firstRow + batchRows + 1 && std::getline(file, line))
+            {
+                rows.push_back(std::move(line));
+            }
+
+            const bool lastBatch{ rows.size() < firstRow + batchRows + 1 };
+            const size_t endRow{ lastBatch ? rows.size() : rows.size() - 1 };
+            const size_t bandCount{ (endRow - firstRow + bandRows - 1) / bandRows };
+            const SchematicTotals batchTotals{ scheduler::parallel_reduce(0, bandCount, SchematicTotals{},
+                [&rows, firstRow, endRow, bandRows](const size_t band)
+                {
+                    const size_t bandStart{ firstRow + band * bandRows };
+                    const size_t bandEnd{ std::min(bandStart + bandRows, endRow) };
+                    const size_t haloStart{ bandStart > 0 ? bandStart - 1 : 0 };
+                    const size_t haloEnd{ std::min(bandEnd + 1, rows.size()) };
+                    const PaddedGrid bandGrid{ makePaddedGrid(std::span{ rows }.subspan(haloStart, haloEnd - haloStart)) };
+                    return summarizeSchematic(bandGrid, bandStart - haloStart, bandEnd - haloStart);
+                },
+                [](const SchematicTotals& a, const SchematicTotals& b)
+                {
+                    return SchematicTotals{ a.partSum + b.partSum, a.gearRatioSum + b.gearRatioSum };
+                }) };
+
+            totals.partSum += batchTotals.partSum;
+            totals.gearRatioSum += batchTotals.gearRatioSum;
+            if (lastBatch)
+            {
+                return totals;
+            }
+
+            // Keep the last row of this batch & the first of the next one.
+            rows.erase(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(endRow - 1));
+            firstRow = 1;
+        }
+    }
+
+    // Cells of a number read at once, the grid has this many extra '.' at its end to allow reading past the
+    // last row.
+    constexpr size_t ringReadWidth{ 8 };
+
+    // Lines split the way std::getline does, the width taken from the longest one & shorter ones padded with '.'.
+    PaddedGrid parsePaddedGrid(const std::string_view input)
+    {
+        PaddedGrid grid{};
+        size_t lineStart{};
+        while (lineStart < input.size())
+        {
+            size_t lineEnd{ input.find('\n', lineStart) };
+            if (lineEnd == std::string_view::npos)
+            {
+                lineEnd = input.size();
+            }
+
+            grid.width = std::max(grid.width, lineEnd - lineStart);
+            grid.height++;
+            lineStart = lineEnd + 1;
+        }
+
+        grid.cells.assign(grid.stride() * (grid.height + 2) + ringReadWidth, '.');
+        lineStart = 0;
+        for (size_t y = 0; y < grid.height; y++)
+        {
+            size_t lineEnd{ input.find('\n', lineStart) };
+            if (lineEnd == std::string_view::npos)
+            {
+                lineEnd = input.size();
+            }
+
+            input.copy(grid.cells.data() + grid.index(0, y), lineEnd - lineStart, lineStart);
+            lineStart = lineEnd + 1;
+        }
+
+        return grid;
+    }
+
+    // Same as parsePaddedGrid, for a schematic already split into lines.
+    PaddedGrid makePaddedGrid(const std::span<const std::string> lines)
+    {
+        PaddedGrid grid{};
+        grid.height = lines.size();
+        for (const std::string& line : lines)
+        {
+            grid.width = std::max(grid.width, line.size());
+        }
+
+        grid.cells.assign(grid.stride() * (grid.height + 2) + ringReadWidth, '.');
+        for (size_t y = 0; y < grid.height; y++)
+        {
+            lines[y].copy(grid.cells.data() + grid.index(0, y), lines[y].size());
+        }
+
+        return grid;
+    }
+
+    // Finds the numbers of each row from a bit per cell a number starts at, & checks them against flags for the
+    // cells of the row having a symbol or gear in the 3x3 square around them. Those flags are computed a row at
+    // a time without branching, so scattered symbols don't cost branch mispredictions. Gears are only tracked
+    // once a number touches them, keyed by their position.
+    SchematicTotals summarizeSchematic(const PaddedGrid& grid)
+    {
+        return summarizeSchematic(grid, 0, grid.height);
+    }
+
+    // Only numbers & gears in the owned rows are counted, numbers in the other rows still count towards the
+    // gears of the owned rows next to them.
+    SchematicTotals summarizeSchematic(const PaddedGrid& grid, const size_t firstOwnedRow, const size_t endOwnedRow)
+    {
+        struct Gear
+        {
+            int adjacentNumbers{};
+            int ratio{ 1 };
+        };
+
+        const std::string& cells{ grid.cells };
+        const size_t stride{ grid.stride() };
+        const auto isDigit = [](const char c) { return static_cast<std::uint8_t>(static_cast<unsigned char>(c - '0') < 10); };
+        const auto isSymbol = [&](const char c) { return static_cast<std::uint8_t>((c != '.') & !isDigit(c)); };
+
+        // Buffers for the current row: whether there's a symbol or gear in each column of the rows around it or
+        // in the 3x3 square around each cell, whether each cell is a digit (shifted one cell to the right, with
+        // room to read past the end) & a bit for each cell a number starts at.
+        std::vector<std::uint8_t> symbolInColumn(stride);
+        std::vector<std::uint8_t> gearInColumn(stride);
+        std::vector<std::uint8_t> nearSymbol(stride + ringReadWidth);
+        std::vector<std::uint8_t> nearGear(stride + ringReadWidth);
+        std::vector<std::uint8_t> digitInRow(stride + 16);
+        std::vector<std::uint64_t> numberStarts((stride + 63) / 64 + 1);
+
+        SchematicTotals totals{};
+        std::unordered_map<size_t, Gear> gears{};
+        for (size_t y = 0; y < grid.height; y++)
+        {
+            const size_t rowStart{ grid.index(0, y) - 1 };
+            const char* above{ cells.data() + rowStart - stride };
+            const char* row{ cells.data() + rowStart };
+            const char* below{ cells.data() + rowStart + stride };
+            for (size_t x = 0; x < stride; x++)
+            {
+                symbolInColumn[x] = isSymbol(above[x]) | isSymbol(row[x]) | isSymbol(below[x]);
+                gearInColumn[x] = (above[x] == '*') | (row[x] == '*') | (below[x] == '*');
+                digitInRow[x + 1] = isDigit(row[x]);
+            }
+
+            for (size_t x = 1; x + 1 < stride; x++)
+            {
+                nearSymbol[x] = symbolInColumn[x - 1] | symbolInColumn[x] | symbolInColumn[x + 1];
+                nearGear[x] = gearInColumn[x - 1] | gearInColumn[x] | gearInColumn[x + 1];
+            }
+
+            // Packs the number starts of 8 cells at a time into their bits.
+            std::ranges::fill(numberStarts, 0);
+            for (size_t x = 0; x < stride; x += 8)
+            {
+                std::uint64_t digits;
+                std::uint64_t digitsBefore;
+                std::memcpy(&digits, digitInRow.data() + x + 1, 8);
+                std::memcpy(&digitsBefore, digitInRow.data() + x, 8);
+                const std::uint64_t starts{ digits & ~digitsBefore };
+                numberStarts[x / 64] |= ((starts * 0x0102040810204080ull) >> 56) << (x % 64);
+            }
+
+            for (size_t word = 0; word < numberStarts.size(); word++)
+            {
+                for (std::uint64_t starts{ numberStarts[word] }; starts != 0; starts &= starts - 1)
+                {
+                    const size_t x{ word * 64 + static_cast<size_t>(std::countr_zero(starts)) };
+
+                    // Digits, nearby symbols & gears of the first ringReadWidth cells are gathered without
+                    // branching on the length of the number, the rest of a longer number after that.
+                    int partNumber{};
+                    bool inNumber{ true };
+                    std::uint8_t symbol{};
+                    std::uint8_t gear{};
+                    size_t length{};
+                    for (size_t offset = 0; offset < ringReadWidth; offset++)
+                    {
+                        const char c{ cells[rowStart + x + offset] };
+                        inNumber &= isDigit(c);
+                        partNumber = inNumber ? partNumber * 10 + (c - '0') : partNumber;
+                        symbol |= inNumber & nearSymbol[x + offset];
+                        gear |= inNumber & nearGear[x + offset];
+                        length += inNumber;
+                    }
+
+                    for (; inNumber && isDigit(cells[rowStart + x + length]); length++)
+                    {
+                        partNumber = partNumber * 10 + (cells[rowStart + x + length] - '0');
+                        symbol |= nearSymbol[x + length];
+                        gear |= nearGear[x + length];
+                    }
+
+                    if (symbol && y >= firstOwnedRow && y < endOwnedRow)
+                    {
+                        totals.partSum += partNumber;
+                    }
+
+                    if (gear)
+                    {
+                        const size_t numberStart{ rowStart + x };
+                        for (size_t ringY = y - 1; ringY != y + 2; ringY++)
+                        {
+                            if (ringY < firstOwnedRow || ringY >= endOwnedRow)
+                            {
+                                continue;
+                            }
+
+                            const size_t ringRow{ numberStart - stride - 1 + (ringY + 1 - y) * stride };
+                            for (size_t cell = ringRow; cell < ringRow + length + 2; cell++)
+                            {
+                                // Only gears with exactly two numbers count, so there's no need to multiply in more.
+                                if (cells[cell] == '*' && ++gears[cell].adjacentNumbers <= 2)
+                                {
+                                    gears[cell].ratio *= partNumber;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        for (const auto& [position, gear] : gears)
+        {
+            if (gear.adjacentNumbers == 2)
+            {
+                totals.gearRatioSum += gear.ratio;
+            }
+        }
+
+        return totals;
+    }
+
+    long long solvePart1Labelled(std::istream& file)
+    {
+        return SchematicIndex{ parsePaddedGrid(readAll(file)) }.partSum();
+    }
+
+    long long solvePart2Labelled(std::istream& file)
+    {
+        return SchematicIndex{ parsePaddedGrid(readAll(file)) }.gearRatioSum();
+    }
+
+    // Applies each "x y c" line of the edits file to the schematic, printing both answers after each edit.
+    void run_schematic_edits(const std::string& schematicFileName, const std::string& editsFileName)
+    {
+        std::ifstream schematicFile{ schematicFileName };
+        std::ifstream editsFile{ editsFileName };
+        if (!schematicFile || !editsFile)
+        {
+            std::cout << (schematicFile ? editsFileName : schematicFileName) << ": could not read file\n";
+            return;
+        }
+
+        SchematicIndex index{ parsePaddedGrid(readAll(schematicFile)) };
+        std::cout << "Part 1 answer: " << index.partSum() << ", part 2 answer: " << index.gearRatioSum() << '\n';
+
+        size_t x;
+        size_t y;
+        char c;
+        while (editsFile >> x >> y >> c)
+        {
+            index.set(x, y, c);
+            std::cout << x << ' ' << y << ' ' << c << ": part 1 answer: " << index.partSum() << ", part 2 answer: "
+                << index.gearRatioSum() << '\n';
+        }
+    }
+
+    SchematicIndex::SchematicIndex(PaddedGrid schematic)
+        : grid{ std::move(schematic) }, labels(grid.cells.size(), -1)
+    {
+        for (size_t y = 0; y < grid.height; y++)
+        {
+            size_t position{ grid.index(0, y) };
+            while (position < grid.index(grid.width, y))
+            {
+                const size_t numberStart{ position };
+                while (std::isdigit(static_cast<unsigned char>(grid.cells[position])))
+                {
+                    position++;
+                }
+
+                if (position > numberStart)
+                {
+                    addNumber(numberStart, position - numberStart);
+                }
+                else
+                {
+                    position++;
+                }
+            }
+        }
+    }
+
+    // Rebuilds the numbers in the row next to the cell, as the edit may have split, joined, shortened or
+    // lengthened them, & the symbol at the cell. Other numbers & symbols only need their adjacency updated,
+    // which adding & removing those does.
+    void SchematicIndex::set(const size_t x, const size_t y, const char c)
+    {
+        if (x >= grid.width || y >= grid.height)
+        {
+            throw std::out_of_range{ "Cell " + std::to_string(x) + "," + std::to_string(y) + " is outside the schematic" };
+        }
+
+        const size_t cell{ grid.index(x, y) };
+        if (grid.cells[cell] == c)
+        {
+            return;
+        }
+
+        size_t rebuildStart{ cell };
+        size_t rebuildEnd{ cell + 1 };
+        for (const size_t neighbour : { cell - 1, cell, cell + 1 })
+        {
+            const int label{ labels[neighbour] };
+            if (label >= 0)
+            {
+                rebuildStart = std::min(rebuildStart, numbers[static_cast<size_t>(label)].start);
+                rebuildEnd = std::max(rebuildEnd, numbers[static_cast<size_t>(label)].start + numbers[static_cast<size_t>(label)].length);
+                removeNumber(label);
+            }
+        }
+
+        if (isSymbol(cell))
+        {
+            removeSymbol(cell);
+        }
+
+        grid.cells[cell] = c;
+
+        size_t position{ rebuildStart };
+        while (position < rebuildEnd)
+        {
+            const size_t numberStart{ position };
+            while (std::isdigit(static_cast<unsigned char>(grid.cells[position])))
+            {
+                position++;
+            }
+
+            if (position > numberStart)
+            {
+                addNumber(numberStart, position - numberStart);
+            }
+            else
+            {
+                position++;
+            }
+        }
+
+        if (isSymbol(cell))
+        {
+            addSymbol(cell);
+        }
+    }
+
+    bool SchematicIndex::isSymbol(const size_t cell) const
+    {
+        return grid.cells[cell] != '.' && !std::isdigit(static_cast<unsigned char>(grid.cells[cell]));
+    }
+
+    // What the symbol at the cell adds to the gear ratio sum.
+    long long SchematicIndex::gearRatio(const size_t cell) const
+    {
+        const auto symbol{ symbolNumbers.find(cell) };
+        if (grid.cells[cell] != '*' || symbol == symbolNumbers.end() || symbol->second.size() != 2)
+        {
+            return 0;
+        }
+
+        return numbers[static_cast<size_t>(symbol->second[0])].value * numbers[static_cast<size_t>(symbol->second[1])].value;
+    }
+
+    void SchematicIndex::addNumber(const size_t start, const size_t length)
+    {
+        int label;
+        if (freeLabels.empty())
+        {
+            label = static_cast<int>(numbers.size());
+            numbers.emplace_back();
+        }
+        else
+        {
+            label = freeLabels.back();
+            freeLabels.pop_back();
+        }
+
+        Number& number{ numbers[static_cast<size_t>(label)] };
+        number = Number{ 0, start, length, 0 };
+        for (size_t cell = start; cell < start + length; cell++)
+        {
+            number.value = number.value * 10 + (grid.cells[cell] - '0');
+            labels[cell] = label;
+        }
+
+        const size_t stride{ grid.stride() };
+        for (size_t ringRow = start - stride - 1; ringRow <= start + stride - 1; ringRow += stride)
+        {
+            for (size_t cell = ringRow; cell < ringRow + length + 2; cell++)
+            {
+                if (isSymbol(cell))
+                {
+                    gearRatios -= gearRatio(cell);
+                    symbolNumbers[cell].push_back(label);
+                    gearRatios += gearRatio(cell);
+                    number.adjacentSymbols++;
+                }
+            }
+        }
+
+        if (number.adjacentSymbols > 0)
+        {
+            parts += number.value;
+        }
+    }
+
+    void SchematicIndex::removeNumber(const int label)
+    {
+        const Number& number{ numbers[static_cast<size_t>(label)] };
+        const size_t stride{ grid.stride() };
+        for (size_t ringRow = number.start - stride - 1; ringRow <= number.start + stride - 1; ringRow += stride)
+        {
+            for (size_t cell = ringRow; cell < ringRow + number.length + 2; cell++)
+            {
+                if (isSymbol(cell))
+                {
+                    gearRatios -= gearRatio(cell);
+                    std::erase(symbolNumbers[cell], label);
+                    gearRatios += gearRatio(cell);
+                }
+            }
+        }
+
+        if (number.adjacentSymbols > 0)
+        {
+            parts -= number.value;
+        }
+
+        std::fill(labels.begin() + static_cast<std::ptrdiff_t>(number.start), labels.begin() + static_cast<std::ptrdiff_t>(number.start + number.length), -1);
+        freeLabels.push_back(label);
+    }
+
+    // Numbers next to the cell rebuilt by the edit already added themselves to it.
+    void SchematicIndex::addSymbol(const size_t cell)
+    {
+        gearRatios -= gearRatio(cell);
+
+        std::vector<int>& adjacentNumbers{ symbolNumbers[cell] };
+        const size_t stride{ grid.stride() };
+        for (const size_t neighbour : { cell - stride - 1, cell - stride, cell - stride + 1, cell - 1, cell + 1, cell + stride - 1, cell + stride, cell + stride + 1 })
+        {
+            const int label{ labels[neighbour] };
+            if (label >= 0 && std::ranges::find(adjacentNumbers, label) == adjacentNumbers.end())
+            {
+                adjacentNumbers.push_back(label);
+                Number& number{ numbers[static_cast<size_t>(label)] };
+                if (number.adjacentSymbols++ == 0)
+                {
+                    parts += number.value;
+                }
+            }
+        }
+
+        gearRatios += gearRatio(cell);
+    }
+
+    void SchematicIndex::removeSymbol(const size_t cell)
+    {
+        gearRatios -= gearRatio(cell);
+
+        const auto symbol{ symbolNumbers.find(cell) };
+        if (symbol == symbolNumbers.end())
+        {
+            return;
+        }
+
+        for (const int label : symbol->second)
+        {
+            Number& number{ numbers[static_cast<size_t>(label)] };
+            if (--number.adjacentSymbols == 0)
+            {
+                parts -= number.value;
+            }
+        }
+
+        symbolNumbers.erase(symbol);
+    }
+}
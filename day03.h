@@ -1,5 +1,88 @@
 #pragma once
+#include <istream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 namespace day03
 {
     void run_day(bool example);
+    int solvePart1(std::istream& file);
+    int solvePart2(std::istream& file);
+
+    // Schematic stored row after row in one string, surrounded by a border of '.' so the neighbours of any
+    // cell inside can be looked at without bounds checks.
+    struct PaddedGrid
+    {
+        std::string cells{};
+        size_t width{};
+        size_t height{};
+
+        [[nodiscard]] size_t stride() const { return width + 2; }
+        [[nodiscard]] size_t index(const size_t x, const size_t y) const { return (y + 1) * stride() + x + 1; }
+    };
+
+    // Both answers, from a single pass over the numbers of the schematic.
+    struct SchematicTotals
+    {
+        int partSum{};
+        int gearRatioSum{};
+    };
+
+    // Labels each digit cell with the number it's part of & keeps the numbers next to each symbol, so editing a
+    // single cell only revisits the numbers & symbols around it to update both answers.
+    class SchematicIndex
+    {
+    public:
+        explicit SchematicIndex(PaddedGrid schematic);
+
+        [[nodiscard]] char at(size_t x, size_t y) const { return grid.cells[grid.index(x, y)]; }
+        void set(size_t x, size_t y, char c);
+
+        [[nodiscard]] long long partSum() const { return parts; }
+        [[nodiscard]] long long gearRatioSum() const { return gearRatios; }
+
+    private:
+        struct Number
+        {
+            long long value{};
+            size_t start{};
+            size_t length{};
+            int adjacentSymbols{};
+        };
+
+        PaddedGrid grid;
+        std::vector<int> labels{};
+        std::vector<Number> numbers{};
+        std::vector<int> freeLabels{};
+        std::unordered_map<size_t, std::vector<int>> symbolNumbers{};
+        long long parts{};
+        long long gearRatios{};
+
+        [[nodiscard]] bool isSymbol(size_t cell) const;
+        [[nodiscard]] long long gearRatio(size_t cell) const;
+        void addNumber(size_t start, size_t length);
+        void removeNumber(int label);
+        void addSymbol(size_t cell);
+        void removeSymbol(size_t cell);
+    };
+
+    PaddedGrid parsePaddedGrid(std::string_view input);
+    PaddedGrid makePaddedGrid(std::span<const std::string> lines);
+    SchematicTotals summarizeSchematic(const PaddedGrid& grid);
+    SchematicTotals summarizeSchematic(const PaddedGrid& grid, size_t firstOwnedRow, size_t endOwnedRow);
+    // Rows per band of the banded solvers. A batch size of 0 reads 4 bands per worker at a time.
+    constexpr size_t defaultBandRows{ 1024 };
+    SchematicTotals summarizeBanded(std::istream& file, size_t bandRows = defaultBandRows, size_t batchBands = 0);
+    int solvePart1SinglePass(std::istream& file);
+    int solvePart2SinglePass(std::istream& file);
+    int solvePart1Banded(std::istream& file);
+    int solvePart2Banded(std::istream& file);
+    int solvePart1BandedNarrow(std::istream& file);
+    int solvePart2BandedNarrow(std::istream& file);
+    long long solvePart1Labelled(std::istream& file);
+    long long solvePart2Labelled(std::istream& file);
+    void run_schematic_edits(const std::string& schematicFileName, const std::string& editsFileName);
 }
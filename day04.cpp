@@ -1,18 +1,28 @@
 #include "day04.h"
+#include "helpers.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <cmath>
 #include <numeric>
+#include <stdexcept>
 #include <string>
 #include <sstream>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DAY04_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace day04
 {
-    int solvePart1(std::ifstream& file);
-    int solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 04 \n";
@@ -31,7 +41,7 @@ namespace day04
         std::cout << "Part 2 answer: " << sum << '\n';
     }
 
-    std::vector<std::pair<std::vector<bool>, std::vector<int>>> parseInput(std::ifstream& file)
+    std::vector<std::pair<std::vector<bool>, std::vector<int>>> parseInput(std::istream& file)
     {
         // Input parsing uses fact that nrs are all <100 to create 100-long array to hold bools marking
         // winning numbers.
@@ -96,7 +106,7 @@ namespace day04
         return input;
     }
 
-    int solvePart1(std::ifstream& file)
+    int solvePart1(std::istream& file)
     {
         const auto input = parseInput(file);
 
@@ -117,7 +127,7 @@ namespace day04
         return sum;
     }
 
-    int solvePart2(std::ifstream& file)
+    int solvePart2(std::istream& file)
     {
         const auto input = parseInput(file);
 
@@ -148,4 +158,351 @@ namespace day04
         // Return sum of count of each card.
         return std::accumulate(nrOfEachCard.begin(), nrOfEachCard.end(), 0);
     }
-}
\ No newline at end of file
+
+    long long solvePart1Bitmask(std::istream& file)
+    {
+        return scoreCards(cardMatches(readAll(file)));
+    }
+
+    int solvePart2Bitmask(std::istream& file)
+    {
+        return countCards(cardMatches(readAll(file)));
+    }
+
+    long long solvePart1FixedColumns(std::istream& file)
+    {
+        return scoreCards(cardMatchesFixed(readAll(file)));
+    }
+
+    int solvePart2FixedColumns(std::istream& file)
+    {
+        return countCards(cardMatchesFixed(readAll(file)));
+    }
+
+    long long solvePart1Streaming(std::istream& file)
+    {
+        const CardPileTotals totals{ summarizeCardStream(file) };
+        if (totals.pointsOverflowed)
+        {
+            throw std::out_of_range{ "scratchcard points don't fit in 64 bits" };
+        }
+
+        return totals.points;
+    }
+
+    long long solvePart2Streaming(std::istream& file)
+    {
+        return summarizeCardStream(file).cards;
+    }
+
+    // Adds the points of a card with the given nr of matches. A card can match up to 128 numbers, so rather
+    // than shifting or adding past 64 bits this throws std::out_of_range once the points don't fit.
+    long long addCardPoints(const long long points, const int matches)
+    {
+        if (matches <= 0)
+        {
+            return points;
+        }
+
+        if (matches > 63)
+        {
+            throw std::out_of_range{ "card with " + std::to_string(matches) + " matches is worth more than 2^62 points" };
+        }
+
+        const long long cardPoints{ 1ll << (matches - 1) };
+        if (points > std::numeric_limits<long long>::max() - cardPoints)
+        {
+            throw std::out_of_range{ "scratchcard points don't fit in 64 bits" };
+        }
+
+        return points + cardPoints;
+    }
+
+    long long scoreCards(const std::vector<int>& matches)
+    {
+        long long points{};
+        for (const int cardMatches : matches)
+        {
+            points = addCardPoints(points, cardMatches);
+        }
+
+        return points;
+    }
+
+    // Start out with 1 of each scratchcard, each card adding its copies to the cards it wins.
+    int countCards(const std::vector<int>& matches)
+    {
+        std::vector<int> nrOfEachCard(matches.size(), 1);
+        for (size_t card = 0; card < matches.size(); card++)
+        {
+            const size_t lastWon{ std::min(card + static_cast<size_t>(matches[card]), matches.size() - 1) };
+            for (size_t won = card + 1; won <= lastWon; won++)
+            {
+                nrOfEachCard[won] += nrOfEachCard[card];
+            }
+        }
+
+        return std::accumulate(nrOfEachCard.begin(), nrOfEachCard.end(), 0);
+    }
+
+    void NumberMask::set(const int number)
+    {
+        if (number < 0 || number >= 128)
+        {
+            throw std::out_of_range{ "Card number " + std::to_string(number) + " doesn't fit a number mask" };
+        }
+
+        (number < 64 ? low : high) |= std::uint64_t{ 1 } << (number % 64);
+    }
+
+    int NumberMask::countCommon(const NumberMask& other) const
+    {
+        return std::popcount(low & other.low) + std::popcount(high & other.high);
+    }
+
+    // Numbers before the '|' are winning ones, the ones after it owned ones. The "Card N:" header is skipped.
+    CardMasks parseCardMasks(const std::string_view line)
+    {
+        CardMasks card{};
+        NumberMask* numbers{ &card.winning };
+        int number{ -1 };
+        for (size_t i{ line.find(':') + 1 }; i < line.size(); i++)
+        {
+            const char c{ line[i] };
+            if (c >= '0' && c <= '9')
+            {
+                number = (number < 0 ? 0 : number * 10) + (c - '0');
+                continue;
+            }
+
+            if (number >= 0)
+            {
+                numbers->set(number);
+                number = -1;
+            }
+
+            if (c == '|')
+            {
+                numbers = &card.owned;
+            }
+        }
+
+        if (number >= 0)
+        {
+            numbers->set(number);
+        }
+
+        return card;
+    }
+
+    // Matches of each card, lines split the way std::getline does.
+    std::vector<int> cardMatches(const std::string_view input)
+    {
+        std::vector<int> matches{};
+        size_t lineStart{};
+        while (lineStart < input.size())
+        {
+            size_t lineEnd{ input.find('\n', lineStart) };
+            if (lineEnd == std::string_view::npos)
+            {
+                lineEnd = input.size();
+            }
+
+            matches.push_back(parseCardMasks(input.substr(lineStart, lineEnd - lineStart)).matches());
+            lineStart = lineEnd + 1;
+        }
+
+        return matches;
+    }
+
+    // Same as cardMatches, parsing the lines matching the layout of the first one with parseFixedCard.
+    std::vector<int> cardMatchesFixed(const std::string_view input)
+    {
+        const std::optional<CardLayout> layout{ detectCardLayout(input.substr(0, input.find('\n'))) };
+
+        std::vector<int> matches{};
+        size_t lineStart{};
+        while (lineStart < input.size())
+        {
+            size_t lineEnd{ input.find('\n', lineStart) };
+            if (lineEnd == std::string_view::npos)
+            {
+                lineEnd = input.size();
+            }
+
+            const std::string_view line{ input.substr(lineStart, lineEnd - lineStart) };
+            std::optional<CardMasks> card{};
+            if (layout)
+            {
+                card = parseFixedCard(line, *layout, input.data() + input.size());
+            }
+
+            matches.push_back((card ? *card : parseCardMasks(line)).matches());
+            lineStart = lineEnd + 1;
+        }
+
+        return matches;
+    }
+
+    std::optional<CardLayout> detectCardLayout(const std::string_view line)
+    {
+        const size_t colon{ line.find(':') };
+        const size_t bar{ line.find('|') };
+        if (colon == std::string_view::npos || bar == std::string_view::npos || bar < colon + 2
+            || (bar - colon - 2) % 3 != 0 || (line.size() - bar - 1) % 3 != 0)
+        {
+            return std::nullopt;
+        }
+
+        return CardLayout{ line.size(), colon, bar, (bar - colon - 2) / 3, (line.size() - bar - 1) / 3 };
+    }
+
+    constexpr size_t fieldsPerBlock{ 5 };
+
+    // Converts up to 5 fields of a space & a 2 character right aligned number at once, leaving the number of
+    // field i in values[3 * i + 2]. Returns false if one of the first nrOfFields fields doesn't look like that.
+    bool convertFieldBlock(const char* block, const size_t nrOfFields, std::uint8_t (&values)[16])
+    {
+#if defined(DAY04_SSE2)
+        const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(block)) };
+        const __m128i offsets{ _mm_sub_epi8(bytes, _mm_set1_epi8('0')) };
+        const __m128i isDigit{ _mm_cmpeq_epi8(_mm_min_epu8(offsets, _mm_set1_epi8(9)), offsets) };
+        const __m128i isSpace{ _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')) };
+
+        // Each field is a space, a tens digit or space & a ones digit.
+        const __m128i separators{ _mm_setr_epi8(-1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, 0) };
+        const __m128i tens{ _mm_setr_epi8(0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0) };
+        const __m128i ones{ _mm_setr_epi8(0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0) };
+        const __m128i valid{ _mm_or_si128(_mm_or_si128(_mm_and_si128(isSpace, separators),
+            _mm_and_si128(_mm_or_si128(isSpace, isDigit), tens)), _mm_and_si128(isDigit, ones)) };
+
+        const int fieldBytes{ (1 << (3 * nrOfFields)) - 1 };
+        if ((_mm_movemask_epi8(valid) & fieldBytes) != fieldBytes)
+        {
+            return false;
+        }
+
+        // Spaces count as 0, then each tens digit times 10 is shifted onto the ones digit after it.
+        const __m128i digits{ _mm_and_si128(offsets, isDigit) };
+        const __m128i twice{ _mm_add_epi8(digits, digits) };
+        const __m128i fourTimes{ _mm_add_epi8(twice, twice) };
+        const __m128i tenTimes{ _mm_add_epi8(_mm_add_epi8(fourTimes, fourTimes), twice) };
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values), _mm_add_epi8(_mm_slli_si128(tenTimes, 1), digits));
+        return true;
+#else
+        for (size_t field = 0; field < nrOfFields; field++)
+        {
+            const char* chars{ block + 3 * field };
+            const bool tensValid{ chars[1] == ' ' || (chars[1] >= '0' && chars[1] <= '9') };
+            if (chars[0] != ' ' || !tensValid || chars[2] < '0' || chars[2] > '9')
+            {
+                return false;
+            }
+
+            values[3 * field + 2] = static_cast<std::uint8_t>((chars[1] == ' ' ? 0 : (chars[1] - '0') * 10) + chars[2] - '0');
+        }
+
+        return true;
+#endif
+    }
+
+    // Parses nrOfFields fields into the mask, a block of fields at a time.
+    bool parseFixedFields(const char* fields, const size_t nrOfFields, const char* inputEnd, NumberMask& numbers)
+    {
+        for (size_t first = 0; first < nrOfFields; first += fieldsPerBlock)
+        {
+            const char* block{ fields + 3 * first };
+            const size_t blockFields{ std::min(fieldsPerBlock, nrOfFields - first) };
+
+            // Blocks are read 16 bytes at a time, copy the last one if that would read past the input.
+            char lastBlock[16]{};
+            if (inputEnd - block < 16)
+            {
+                std::memcpy(lastBlock, block, 3 * blockFields);
+                block = lastBlock;
+            }
+
+            std::uint8_t values[16];
+            if (!convertFieldBlock(block, blockFields, values))
+            {
+                return false;
+            }
+
+            for (size_t field = 0; field < blockFields; field++)
+            {
+                numbers.set(values[3 * field + 2]);
+            }
+        }
+
+        return true;
+    }
+
+    // Empty if the line doesn't follow the layout, parseCardMasks handles it then.
+    std::optional<CardMasks> parseFixedCard(const std::string_view line, const CardLayout& layout, const char* inputEnd)
+    {
+        if (line.size() != layout.lineLength || line[layout.colon] != ':' || line[layout.bar] != '|' || line[layout.bar - 1] != ' ')
+        {
+            return std::nullopt;
+        }
+
+        CardMasks card{};
+        if (!parseFixedFields(line.data() + layout.colon + 1, layout.nrOfWinning, inputEnd, card.winning)
+            || !parseFixedFields(line.data() + layout.bar + 1, layout.nrOfOwned, inputEnd, card.owned))
+        {
+            return std::nullopt;
+        }
+
+        return card;
+    }
+
+    // Scores & counts cards while reading them, without keeping the pile. A card only wins copies of the next
+    // matches cards, which is at most 128 as masks hold numbers up to 127, so the copies won of the upcoming
+    // cards fit a circular buffer of 128. Copies won past the last card are never read.
+    CardPileTotals summarizeCardStream(std::istream& file)
+    {
+        constexpr size_t maxMatches{ 128 };
+        std::array<long long, maxMatches> copiesWon{};
+
+        CardPileTotals totals{};
+        std::optional<CardLayout> layout{};
+        std::string line{};
+        for (size_t card = 0; std::getline(file, line); card++)
+        {
+            if (card == 0)
+            {
+                layout = detectCardLayout(line);
+            }
+
+            std::optional<CardMasks> masks{};
+            if (layout)
+            {
+                masks = parseFixedCard(line, *layout, line.data() + line.size());
+            }
+
+            const int matches{ (masks ? *masks : parseCardMasks(line)).matches() };
+            const size_t slot{ card % maxMatches };
+            const long long copies{ 1 + copiesWon[slot] };
+            copiesWon[slot] = 0;
+
+            totals.cards += copies;
+            if (!totals.pointsOverflowed)
+            {
+                try
+                {
+                    totals.points = addCardPoints(totals.points, matches);
+                }
+                catch (const std::out_of_range&)
+                {
+                    totals.pointsOverflowed = true;
+                }
+            }
+
+            for (size_t won = 1; won <= static_cast<size_t>(matches); won++)
+            {
+                copiesWon[(slot + won) % maxMatches] += copies;
+            }
+        }
+
+        return totals;
+    }
+}
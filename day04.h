@@ -1,5 +1,67 @@
 #pragma once
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
 namespace day04
 {
     void run_day(bool example);
+    int solvePart1(std::istream& file);
+    int solvePart2(std::istream& file);
+
+    // Set of card numbers below 128, one bit each.
+    struct NumberMask
+    {
+        std::uint64_t low{};
+        std::uint64_t high{};
+
+        void set(int number);
+        [[nodiscard]] int countCommon(const NumberMask& other) const;
+    };
+
+    struct CardMasks
+    {
+        NumberMask winning{};
+        NumberMask owned{};
+
+        [[nodiscard]] int matches() const { return winning.countCommon(owned); }
+    };
+
+    // Columns shared by all lines of a card pile: "Card NNN:", then fields of a space & a 2 character right
+    // aligned number, " |" & more such fields. Taken from the first line.
+    struct CardLayout
+    {
+        size_t lineLength{};
+        size_t colon{};
+        size_t bar{};
+        size_t nrOfWinning{};
+        size_t nrOfOwned{};
+    };
+
+    struct CardPileTotals
+    {
+        long long points{};
+        long long cards{};
+
+        // Set once the points no longer fit a long long, points is meaningless then.
+        bool pointsOverflowed{};
+    };
+
+    CardMasks parseCardMasks(std::string_view line);
+    std::optional<CardLayout> detectCardLayout(std::string_view line);
+    std::optional<CardMasks> parseFixedCard(std::string_view line, const CardLayout& layout, const char* inputEnd);
+    std::vector<int> cardMatches(std::string_view input);
+    std::vector<int> cardMatchesFixed(std::string_view input);
+    long long addCardPoints(long long points, int matches);
+    long long scoreCards(const std::vector<int>& matches);
+    int countCards(const std::vector<int>& matches);
+    long long solvePart1Bitmask(std::istream& file);
+    int solvePart2Bitmask(std::istream& file);
+    long long solvePart1FixedColumns(std::istream& file);
+    int solvePart2FixedColumns(std::istream& file);
+    CardPileTotals summarizeCardStream(std::istream& file);
+    long long solvePart1Streaming(std::istream& file);
+    long long solvePart2Streaming(std::istream& file);
 }
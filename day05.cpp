@@ -1,18 +1,19 @@
 #include "day05.h"
 #include "helpers.h"
+#include "scheduler.h"
 
+#include <algorithm>
 #include <array>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <string>
 #include <sstream>
 #include <vector>
 
 namespace day05
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 05 " << (example ? "(example)" : "") << '\n';
@@ -28,22 +29,10 @@ namespace day05
         std::cout << "Part 2 answer: " << solvePart2(file) << '\n';
     }
 
-    struct range
-    {
-        long long start{};
-        long long end{};
-    };
-
-    struct rangeMapping
-    {
-        range source{};
-        long long offSet{};
-    };
-
     // Parses the mapping section of input to a list of mapping sections,
     // each mapping section contains a list of range-mappings, where each range-mapping
     // consists of a source range and an offset by which mapping happens.
-    std::vector<std::vector<rangeMapping>> parseMappings(std::ifstream& file)
+    std::vector<std::vector<rangeMapping>> parseMappings(std::istream& file)
     {
         std::string line;
         std::vector<std::vector<rangeMapping>> mappings(0);
@@ -90,7 +79,7 @@ namespace day05
     // Parses input into a pair, first of which is list of seed numbers, second is a list
     // of mappings, where each mapping is a a list of mapping-ranges, which consist of three integers
     // (start target, start source, length) each.
-    std::pair<std::vector<long long>, std::vector<std::vector<rangeMapping>>> parseInputPart1(std::ifstream& file)
+    std::pair<std::vector<long long>, std::vector<std::vector<rangeMapping>>> parseInputPart1(std::istream& file)
     {
         // First parse the seeds
         std::string line;
@@ -109,7 +98,7 @@ namespace day05
     // Parses input into a pair, first of which is list of seed ranges, second is a list
     // of mappings, where each mapping is a a list of mapping-ranges, which consist of three integers
     // (start target, start source, length) each.
-    std::pair<std::vector<range>, std::vector<std::vector<rangeMapping>>> parseInputPart2(std::ifstream& file)
+    std::pair<std::vector<range>, std::vector<std::vector<rangeMapping>>> parseInputPart2(std::istream& file)
     {
         // First parse the seeds
         std::string line;
@@ -132,7 +121,7 @@ namespace day05
         return { seedRanges, mappings };
     }
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         // Parse the input
         auto [seeds, mappings] = parseInputPart1(file);
@@ -146,7 +135,7 @@ namespace day05
                 // Check each range for the correct one
                 for (const auto& mappingRange : fullMapping)
                 {
-                    if (value > mappingRange.source.start && value < mappingRange.source.end)
+                    if (value >= mappingRange.source.start && value < mappingRange.source.end)
                     {
                         // Update the seed by the difference in start of range.
                         value += mappingRange.offSet;
@@ -160,7 +149,7 @@ namespace day05
         return std::ranges::min(seeds);
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         // Parse the input
         auto [seedRanges, mappings] = parseInputPart2(file);
@@ -231,4 +220,407 @@ namespace day05
         auto minOfRanges = [](range a, range b) { return (a.start < b.start); };
         return std::ranges::min(seedRanges, minOfRanges).start;
     }
-}
\ No newline at end of file
+
+    long long solvePart1Composed(std::istream& file)
+    {
+        const auto [seeds, mappings] = parseInputPart1(file);
+        const ComposedMapping composed{ mappings };
+
+        long long lowest{ std::numeric_limits<long long>::max() };
+        for (const long long seed : seeds)
+        {
+            lowest = std::min(lowest, composed.map(seed));
+        }
+
+        return lowest;
+    }
+
+    long long solvePart2Composed(std::istream& file)
+    {
+        const auto [seedRanges, mappings] = parseInputPart2(file);
+        const ComposedMapping composed{ mappings };
+
+        long long lowest{ std::numeric_limits<long long>::max() };
+        for (const range& seedRange : seedRanges)
+        {
+            if (seedRange.end > seedRange.start)
+            {
+                lowest = std::min(lowest, composed.minimum(seedRange));
+            }
+        }
+
+        return lowest;
+    }
+
+    long long solvePart1Batch(std::istream& file)
+    {
+        const auto [seeds, mappings] = parseInputPart1(file);
+        return std::ranges::min(ComposedMapping{ mappings }.mapAll(seeds));
+    }
+
+    // Maps each seed of a seeds file through the mappings of an almanac, printing the locations.
+    void run_map_seeds(const std::string& almanacFileName, const std::string& seedsFileName)
+    {
+        std::ifstream almanacFile{ almanacFileName };
+        std::ifstream seedsFile{ seedsFileName };
+        if (!almanacFile || !seedsFile)
+        {
+            std::cout << (almanacFile ? seedsFileName : almanacFileName) << ": could not read file\n";
+            return;
+        }
+
+        const ComposedMapping composed{ parseInputPart1(almanacFile).second };
+
+        std::vector<long long> seeds{};
+        long long seed{};
+        while (seedsFile >> seed)
+        {
+            seeds.push_back(seed);
+        }
+
+        const std::vector<long long> locations{ composed.mapAll(seeds) };
+        for (size_t i = 0; i < seeds.size(); i++)
+        {
+            std::cout << seeds[i] << ": " << locations[i] << '\n';
+        }
+    }
+
+    long long solvePart2ReverseIndex(std::istream& file)
+    {
+        const auto [seedRanges, mappings] = parseInputPart2(file);
+        return ReverseIndex{ seedRanges, mappings }.kthLocation(1).value();
+    }
+
+    // Answers the queries of a queries file on the seed ranges & mappings of an almanac. Each line is either
+    // "reach a b", for the seeds reaching a location from a up to & including b, or "kth k".
+    void run_reverse_queries(const std::string& almanacFileName, const std::string& queriesFileName)
+    {
+        std::ifstream almanacFile{ almanacFileName };
+        std::ifstream queriesFile{ queriesFileName };
+        if (!almanacFile || !queriesFile)
+        {
+            std::cout << (almanacFile ? queriesFileName : almanacFileName) << ": could not read file\n";
+            return;
+        }
+
+        const auto [seedRanges, mappings] = parseInputPart2(almanacFile);
+        const ReverseIndex index{ seedRanges, mappings };
+
+        std::string query;
+        while (queriesFile >> query)
+        {
+            if (query == "reach")
+            {
+                long long first{};
+                long long last{};
+                queriesFile >> first >> last;
+
+                std::cout << "reach " << first << ' ' << last << ':';
+                for (const range& seeds : index.seedsReaching({ first, last + 1 }))
+                {
+                    std::cout << ' ' << seeds.start << '-' << seeds.end - 1;
+                }
+
+                std::cout << '\n';
+            }
+            else if (query == "kth")
+            {
+                long long k{};
+                queriesFile >> k;
+
+                const std::optional<long long> location{ index.kthLocation(k) };
+                std::cout << "kth " << k << ": " << (location ? std::to_string(*location) : "none") << '\n';
+            }
+            else
+            {
+                std::cout << query << ": unknown query\n";
+                std::string rest;
+                std::getline(queriesFile, rest);
+            }
+        }
+    }
+
+    using Piece = ComposedMapping::Piece;
+
+    // Adds a piece after the last one, replacing the last one if it starts at the same value & merging the
+    // two if they have the same offset.
+    void appendPiece(std::vector<Piece>& pieces, const Piece piece)
+    {
+        if (!pieces.empty() && pieces.back().start == piece.start)
+        {
+            pieces.pop_back();
+        }
+
+        if (pieces.empty() || pieces.back().offSet != piece.offSet)
+        {
+            pieces.push_back(piece);
+        }
+    }
+
+    // A single mapping section as pieces, values outside of all sources mapping to themselves. Where sources
+    // overlap the range listed first wins, as in solvePart1 & solvePart2.
+    std::vector<Piece> sectionPieces(const std::vector<rangeMapping>& section)
+    {
+        // Cut the values at every source bound, then give each cut the offset of the first range covering it.
+        std::vector<long long> bounds{};
+        for (const rangeMapping& mapping : section)
+        {
+            if (mapping.source.end > mapping.source.start)
+            {
+                bounds.push_back(mapping.source.start);
+                bounds.push_back(mapping.source.end);
+            }
+        }
+
+        std::ranges::sort(bounds);
+        const auto duplicates{ std::ranges::unique(bounds) };
+        bounds.erase(duplicates.begin(), duplicates.end());
+
+        std::vector<std::optional<long long>> cutOffSets(bounds.size());
+        for (const rangeMapping& mapping : section)
+        {
+            if (mapping.source.end <= mapping.source.start)
+            {
+                continue;
+            }
+
+            const auto first{ std::ranges::lower_bound(bounds, mapping.source.start) - bounds.begin() };
+            const auto end{ std::ranges::lower_bound(bounds, mapping.source.end) - bounds.begin() };
+            for (auto cut = first; cut < end; cut++)
+            {
+                if (!cutOffSets[static_cast<size_t>(cut)])
+                {
+                    cutOffSets[static_cast<size_t>(cut)] = mapping.offSet;
+                }
+            }
+        }
+
+        std::vector<Piece> pieces{ { std::numeric_limits<long long>::min(), 0 } };
+        for (size_t cut = 0; cut < bounds.size(); cut++)
+        {
+            appendPiece(pieces, { bounds[cut], cutOffSets[cut].value_or(0) });
+        }
+
+        return pieces;
+    }
+
+    // Index of the piece containing the value.
+    size_t findPiece(const std::vector<Piece>& pieces, const long long value)
+    {
+        const auto after{ std::ranges::upper_bound(pieces, value, {}, &Piece::start) };
+        return static_cast<size_t>(after - pieces.begin()) - 1;
+    }
+
+    // Pieces of applying first, then second. Each piece of first is cut where its image crosses a start of
+    // second, keeping the pieces sorted.
+    std::vector<Piece> composePieces(const std::vector<Piece>& first, const std::vector<Piece>& second)
+    {
+        std::vector<Piece> composed{};
+        for (size_t i = 0; i < first.size(); i++)
+        {
+            const Piece& piece{ first[i] };
+            size_t target{ findPiece(second, piece.start + piece.offSet) };
+            appendPiece(composed, { piece.start, piece.offSet + second[target].offSet });
+
+            // The last piece of both maps values to themselves, so it ends where the image does.
+            const long long imageEnd{ i + 1 < first.size() ? first[i + 1].start + piece.offSet : std::numeric_limits<long long>::max() };
+            for (target++; target < second.size() && second[target].start < imageEnd; target++)
+            {
+                appendPiece(composed, { second[target].start - piece.offSet, piece.offSet + second[target].offSet });
+            }
+        }
+
+        return composed;
+    }
+
+    ComposedMapping::ComposedMapping(const std::vector<std::vector<rangeMapping>>& mappings)
+        : breakpoints{ { std::numeric_limits<long long>::min(), 0 } }
+    {
+        for (const auto& section : mappings)
+        {
+            breakpoints = composePieces(breakpoints, sectionPieces(section));
+        }
+    }
+
+    long long ComposedMapping::map(const long long value) const
+    {
+        return value + breakpoints[findPiece(breakpoints, value)].offSet;
+    }
+
+    // Within a piece the lowest value maps lowest, so only the start of the range & of the pieces inside it
+    // can map to the minimum.
+    long long ComposedMapping::minimum(const range& values) const
+    {
+        size_t piece{ findPiece(breakpoints, values.start) };
+        long long lowest{ values.start + breakpoints[piece].offSet };
+        for (piece++; piece < breakpoints.size() && breakpoints[piece].start < values.end; piece++)
+        {
+            lowest = std::min(lowest, breakpoints[piece].start + breakpoints[piece].offSet);
+        }
+
+        return lowest;
+    }
+
+    std::vector<long long> ComposedMapping::mapAll(const std::span<const long long> values) const
+    {
+        constexpr size_t chunkSize{ 1 << 16 };
+
+        std::vector<long long> mapped(values.size());
+        const size_t nrOfChunks{ (values.size() + chunkSize - 1) / chunkSize };
+        scheduler::parallel_for(0, nrOfChunks, [&](const size_t chunk)
+        {
+            const size_t begin{ chunk * chunkSize };
+            const size_t end{ std::min(begin + chunkSize, values.size()) };
+
+            // Values with their index, so the results can be put back in order.
+            std::vector<std::pair<long long, size_t>> sorted{};
+            sorted.reserve(end - begin);
+            for (size_t i = begin; i < end; i++)
+            {
+                sorted.emplace_back(values[i], i);
+            }
+
+            std::ranges::sort(sorted);
+
+            size_t piece{ findPiece(breakpoints, sorted.front().first) };
+            for (const auto& [value, index] : sorted)
+            {
+                while (piece + 1 < breakpoints.size() && breakpoints[piece + 1].start <= value)
+                {
+                    piece++;
+                }
+
+                mapped[index] = value + breakpoints[piece].offSet;
+            }
+        });
+
+        return mapped;
+    }
+
+    // Sorts the ranges, joining the ones that overlap or touch & dropping empty ones.
+    std::vector<range> mergeRanges(std::vector<range> ranges)
+    {
+        std::ranges::sort(ranges, [](const range& a, const range& b) { return a.start < b.start; });
+
+        std::vector<range> merged{};
+        for (const range& r : ranges)
+        {
+            if (r.end <= r.start)
+            {
+                continue;
+            }
+
+            if (!merged.empty() && r.start <= merged.back().end)
+            {
+                merged.back().end = std::max(merged.back().end, r.end);
+            }
+            else
+            {
+                merged.push_back(r);
+            }
+        }
+
+        return merged;
+    }
+
+    ReverseIndex::ReverseIndex(const std::vector<range>& seedRanges, const std::vector<std::vector<rangeMapping>>& mappings)
+        : seeds{ mergeRanges(seedRanges) }
+    {
+        for (const auto& section : mappings)
+        {
+            const std::vector<Piece> pieces{ sectionPieces(section) };
+
+            Section& reverse{ sections.emplace_back() };
+            for (size_t i = 0; i < pieces.size(); i++)
+            {
+                const long long end{ i + 1 < pieces.size() ? pieces[i + 1].start : std::numeric_limits<long long>::max() };
+                reverse.preimages.push_back({ { pieces[i].start + pieces[i].offSet, end + pieces[i].offSet }, pieces[i].offSet });
+            }
+
+            std::ranges::sort(reverse.preimages, [](const Preimage& a, const Preimage& b) { return a.target.start < b.target.start; });
+            for (const Preimage& preimage : reverse.preimages)
+            {
+                reverse.highestEnds.push_back(std::max(reverse.highestEnds.empty() ? preimage.target.end : reverse.highestEnds.back(), preimage.target.end));
+            }
+        }
+
+        // Each seed range reaches the image of every composed piece it overlaps.
+        const ComposedMapping composed{ mappings };
+        const std::vector<Piece>& pieces{ composed.pieces() };
+        std::vector<range> images{};
+        for (const range& seedRange : seeds)
+        {
+            for (size_t piece = findPiece(pieces, seedRange.start); piece < pieces.size() && pieces[piece].start < seedRange.end; piece++)
+            {
+                const long long pieceEnd{ piece + 1 < pieces.size() ? pieces[piece + 1].start : std::numeric_limits<long long>::max() };
+                images.push_back({ std::max(seedRange.start, pieces[piece].start) + pieces[piece].offSet,
+                    std::min(seedRange.end, pieceEnd) + pieces[piece].offSet });
+            }
+        }
+
+        reached = mergeRanges(images);
+        long long before{};
+        for (const range& locations : reached)
+        {
+            reachedBefore.push_back(before);
+            before += locations.end - locations.start;
+        }
+    }
+
+    std::vector<range> ReverseIndex::seedsReaching(const range& locations) const
+    {
+        std::vector<range> current{ mergeRanges({ locations }) };
+        for (auto section = sections.rbegin(); section != sections.rend(); section++)
+        {
+            std::vector<range> pulledBack{};
+            for (const range& values : current)
+            {
+                // Only preimages starting before the end of the values & ending after their start overlap them,
+                // the highest ends so far rule out a prefix of the ones starting before.
+                const auto& preimages{ section->preimages };
+                const auto last{ std::ranges::lower_bound(preimages, values.end, {}, [](const Preimage& p) { return p.target.start; }) };
+                const auto first{ std::ranges::upper_bound(section->highestEnds, values.start) - section->highestEnds.begin() };
+                for (auto preimage = preimages.begin() + first; preimage < last; preimage++)
+                {
+                    const long long start{ std::max(values.start, preimage->target.start) };
+                    const long long end{ std::min(values.end, preimage->target.end) };
+                    if (end > start)
+                    {
+                        pulledBack.push_back({ start - preimage->offSet, end - preimage->offSet });
+                    }
+                }
+            }
+
+            current = mergeRanges(pulledBack);
+        }
+
+        // Keep the parts that are seeds, both lists being sorted & disjoint.
+        std::vector<range> reaching{};
+        auto seedRange{ seeds.begin() };
+        for (const range& values : current)
+        {
+            while (seedRange != seeds.end() && seedRange->end <= values.start)
+            {
+                seedRange++;
+            }
+
+            for (auto overlapping = seedRange; overlapping != seeds.end() && overlapping->start < values.end; overlapping++)
+            {
+                reaching.push_back({ std::max(values.start, overlapping->start), std::min(values.end, overlapping->end) });
+            }
+        }
+
+        return reaching;
+    }
+
+    std::optional<long long> ReverseIndex::kthLocation(const long long k) const
+    {
+        if (k < 1 || reached.empty() || k > reachedBefore.back() + reached.back().end - reached.back().start)
+        {
+            return std::nullopt;
+        }
+
+        const size_t locations{ static_cast<size_t>(std::ranges::upper_bound(reachedBefore, k - 1) - reachedBefore.begin()) - 1 };
+        return reached[locations].start + (k - 1 - reachedBefore[locations]);
+    }
+}
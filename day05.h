@@ -1,5 +1,101 @@
 #pragma once
+#include <istream>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace day05
 {
     void run_day(bool example);
-}
+    long long solvePart1(std::istream& file);
+    long long solvePart2(std::istream& file);
+
+    struct range
+    {
+        long long start{};
+        long long end{};
+    };
+
+    struct rangeMapping
+    {
+        range source{};
+        long long offSet{};
+    };
+
+    std::vector<std::vector<rangeMapping>> parseMappings(std::istream& file);
+    std::pair<std::vector<long long>, std::vector<std::vector<rangeMapping>>> parseInputPart1(std::istream& file);
+    std::pair<std::vector<range>, std::vector<std::vector<rangeMapping>>> parseInputPart2(std::istream& file);
+
+    // All mapping sections composed into a single piecewise-linear function, so mapping a value costs one
+    // binary search however many sections there are. Where sources within a section overlap, the range listed
+    // first wins, as in the reference solvers.
+    class ComposedMapping
+    {
+    public:
+        // Maps the values from start up to the start of the next piece by adding offSet.
+        struct Piece
+        {
+            long long start{};
+            long long offSet{};
+        };
+
+        explicit ComposedMapping(const std::vector<std::vector<rangeMapping>>& mappings);
+
+        [[nodiscard]] long long map(long long value) const;
+
+        // Lowest value the range maps to, the range must not be empty.
+        [[nodiscard]] long long minimum(const range& values) const;
+
+        // Maps many values at once, sorting chunks of them & walking each chunk along the pieces in a single
+        // pass, chunks in parallel. Results are in the order of the values.
+        [[nodiscard]] std::vector<long long> mapAll(std::span<const long long> values) const;
+
+        [[nodiscard]] const std::vector<Piece>& pieces() const { return breakpoints; }
+
+    private:
+        std::vector<Piece> breakpoints{};
+    };
+
+    // Pulls location intervals back through the mapping sections to the seeds reaching them, a binary search
+    // per section & interval. Also keeps the locations the seed ranges reach, for order statistics.
+    class ReverseIndex
+    {
+    public:
+        ReverseIndex(const std::vector<range>& seedRanges, const std::vector<std::vector<rangeMapping>>& mappings);
+
+        // Seeds mapping to a location in the given range, as sorted disjoint ranges.
+        [[nodiscard]] std::vector<range> seedsReaching(const range& locations) const;
+
+        // The k-th smallest location reached by a seed, counting from 1. Empty if fewer locations are reached.
+        [[nodiscard]] std::optional<long long> kthLocation(long long k) const;
+
+    private:
+        // A piece of a mapping section seen from its targets, coming from the values offSet lower.
+        struct Preimage
+        {
+            range target{};
+            long long offSet{};
+        };
+
+        // Preimages sorted on the start of their target, with the highest target end up to each of them.
+        struct Section
+        {
+            std::vector<Preimage> preimages{};
+            std::vector<long long> highestEnds{};
+        };
+
+        std::vector<Section> sections{};
+        std::vector<range> seeds{};
+        std::vector<range> reached{};
+        std::vector<long long> reachedBefore{};
+    };
+
+    long long solvePart1Composed(std::istream& file);
+    long long solvePart2Composed(std::istream& file);
+    long long solvePart1Batch(std::istream& file);
+    void run_map_seeds(const std::string& almanacFileName, const std::string& seedsFileName);
+    long long solvePart2ReverseIndex(std::istream& file);
+    void run_reverse_queries(const std::string& almanacFileName, const std::string& queriesFileName);
+}
\ No newline at end of file
@@ -9,9 +9,6 @@
 
 namespace day06
 {
-    int solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 06 " << (example ? "(example)" : "") << '\n';
@@ -27,7 +24,7 @@ namespace day06
         std::cout << "Part 2 answer: " << solvePart2(file) << '\n';
     }
 
-    int solvePart1(std::ifstream& file)
+    int solvePart1(std::istream& file)
     {
         std::string line;
         std::getline(file, line);
@@ -62,7 +59,7 @@ namespace day06
         return totalProduct;
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         std::string line;
         std::getline(file, line);
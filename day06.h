@@ -1,5 +1,9 @@
 #pragma once
+#include <istream>
+
 namespace day06
 {
     void run_day(bool example);
+    int solvePart1(std::istream& file);
+    long long solvePart2(std::istream& file);
 }
@@ -9,9 +9,6 @@
 
 namespace day07
 {
-    int solvePart1(std::ifstream& file);
-    int solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 07 " << (example ? "(example)" : "") << '\n';
@@ -317,7 +314,7 @@ namespace day07
         return false;
     }
 
-    std::vector<hand> parseInputToHands(std::ifstream& file)
+    std::vector<hand> parseInputToHands(std::istream& file)
     {
         std::string line;
         std::vector<hand> hands{};
@@ -333,7 +330,7 @@ namespace day07
         return hands;
     }
 
-    int solvePart1(std::ifstream& file)
+    int solvePart1(std::istream& file)
     {
         // Parse input
         std::vector<hand> hands{ parseInputToHands(file) };
@@ -351,7 +348,7 @@ namespace day07
         return sum;
     }
 
-    int solvePart2(std::ifstream& file)
+    int solvePart2(std::istream& file)
     {
         // Parse input
         std::vector<hand> hands{ parseInputToHands(file) };
@@ -1,4 +1,5 @@
 #include "day08.h"
+#include "cancellation.h"
 
 #include <algorithm>
 #include <cassert>
@@ -13,10 +14,6 @@
 
 namespace day08
 {
-    int solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-    long long altSolvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 08 " << (example ? "(example)" : "") << '\n';
@@ -39,7 +36,7 @@ namespace day08
         std::unordered_map<std::string, std::pair<std::string, std::string>> connections;
     };
 
-    Map parseInput(std::ifstream& file)
+    Map parseInput(std::istream& file)
     {
         // Get directions
         std::string directions;
@@ -66,7 +63,7 @@ namespace day08
     }
 
 
-    int solvePart1(std::ifstream& file)
+    int solvePart1(std::istream& file)
     {
         auto map = parseInput(file);
         std::string location{ "AAA" };
@@ -91,7 +88,7 @@ namespace day08
         return stepsTaken;
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         auto map = parseInput(file);
 
@@ -111,6 +108,8 @@ namespace day08
         // Loop while any of our locations do not end with 'Z'
         while (std::ranges::any_of(locations, [](const std::string& location) {return !location.ends_with('Z'); }))
         {
+            cancellation::checkpoint();
+
             if (directionIndex >= map.directions.size())
             {
                 directionIndex = 0;
@@ -125,17 +124,12 @@ namespace day08
 
             stepsTaken++;
             directionIndex++;
-
-            if (stepsTaken % 1000000 == 0)
-            {
-                std::cout << stepsTaken << '\n';
-            }
         }
 
         return stepsTaken;
     }
 
-    long long altSolvePart2(std::ifstream& file)
+    long long altSolvePart2(std::istream& file)
     {
         auto map = parseInput(file);
 
@@ -161,6 +155,8 @@ namespace day08
         // Also turns out all starts have period equal to initial, which simplifies equation solving.
         while (std::ranges::any_of(periodBetweenZ, [](const int p) {return p == -1; }))
         {
+            cancellation::checkpoint();
+
             if (directionIndex >= map.directions.size())
             {
                 directionIndex = 0;
@@ -1,5 +1,10 @@
 #pragma once
+#include <istream>
+
 namespace day08
 {
     void run_day(bool example);
+    int solvePart1(std::istream& file);
+    long long solvePart2(std::istream& file);
+    long long altSolvePart2(std::istream& file);
 }
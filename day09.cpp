@@ -11,9 +11,6 @@
 
 namespace day09
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 09 " << (example ? "(example)" : "") << '\n';
@@ -31,7 +28,7 @@ namespace day09
 
     using numberList = std::vector<int>;
 
-    std::vector<numberList> parseInput(std::ifstream& file)
+    std::vector<numberList> parseInput(std::istream& file)
     {
         std::vector<numberList> lines{};
         std::string line;
@@ -56,7 +53,7 @@ namespace day09
     }
 
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         const auto input{ parseInput(file) };
         long long totalSum{};
@@ -80,7 +77,7 @@ namespace day09
         return totalSum;
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         const auto input{ parseInput(file) };
         long long totalSum{};
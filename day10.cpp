@@ -1,4 +1,5 @@
 #include "day10.h"
+#include "grid.h"
 #include "helpers.h"
 
 #include <algorithm>
@@ -13,9 +14,6 @@
 
 namespace day10
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 10 " << (example ? "(example)" : "") << '\n';
@@ -32,21 +30,7 @@ namespace day10
         std::cout << "Part 2 answer: " << solvePart2(file) << '\n';
     }
 
-    struct Point
-    {
-        size_t x;
-        size_t y;
-
-        bool operator==(const Point& other) const
-        {
-            return other.x == x && other.y == y;
-        }
-
-        bool operator!=(const Point& other) const
-        {
-            return !(*this == other);
-        }
-    };
+    using Point = GridPos;
 
     struct PipeMap
     {
@@ -73,7 +57,7 @@ namespace day10
 
         [[nodiscard]] char charAt(Point p) const
         {
-            return mapSymbols[p.y][p.x];
+            return mapSymbols[p.y()][p.x()];
         }
 
         // Returns a (maybe empty) list of points pipe at p connects to.
@@ -84,51 +68,51 @@ namespace day10
             switch (char c{ charAt(p) })
             {
                 case '|':
-                    if (p.y > 0)
-                        result.push_back(Point{ p.x, p.y - 1 });
+                    if (p.y() > 0)
+                        result.push_back(p + GridPos::north);
 
-                    if (p.y < height - 1)
-                        result.push_back(Point{ p.x, p.y + 1 });
+                    if (p.y() < height - 1)
+                        result.push_back(p + GridPos::south);
                     break;
 
                 case '-':
-                    if (p.x > 0)
-                        result.push_back(Point{ p.x - 1, p.y });
+                    if (p.x() > 0)
+                        result.push_back(p + GridPos::west);
 
-                    if (p.x < width - 1)
-                        result.push_back(Point{ p.x + 1, p.y });
+                    if (p.x() < width - 1)
+                        result.push_back(p + GridPos::east);
                     break;
 
                 case 'L':
-                    if (p.y > 0)
-                        result.push_back(Point{ p.x, p.y - 1 });
+                    if (p.y() > 0)
+                        result.push_back(p + GridPos::north);
 
-                    if (p.x < width - 1)
-                        result.push_back(Point{ p.x + 1, p.y });
+                    if (p.x() < width - 1)
+                        result.push_back(p + GridPos::east);
                     break;
 
                 case 'J':
-                    if (p.y > 0)
-                        result.push_back(Point{ p.x, p.y - 1 });
+                    if (p.y() > 0)
+                        result.push_back(p + GridPos::north);
 
-                    if (p.x > 0)
-                        result.push_back(Point{ p.x - 1, p.y });
+                    if (p.x() > 0)
+                        result.push_back(p + GridPos::west);
                     break;
 
                 case '7':
-                    if (p.x > 0)
-                        result.push_back(Point{ p.x - 1, p.y });
+                    if (p.x() > 0)
+                        result.push_back(p + GridPos::west);
 
-                    if (p.y < height - 1)
-                        result.push_back(Point{ p.x, p.y + 1 });
+                    if (p.y() < height - 1)
+                        result.push_back(p + GridPos::south);
                     break;
 
                 case 'F':
-                    if (p.x < width - 1)
-                        result.push_back(Point{ p.x + 1, p.y });
+                    if (p.x() < width - 1)
+                        result.push_back(p + GridPos::east);
 
-                    if (p.y < height - 1)
-                        result.push_back(Point{ p.x, p.y + 1 });
+                    if (p.y() < height - 1)
+                        result.push_back(p + GridPos::south);
                     break;
 
                 case '.':
@@ -155,36 +139,36 @@ namespace day10
         {
             std::vector<Point> result{};
             Point potentialPoint{};
-            if (p.x > 0)
+            if (p.x() > 0)
             {
-                potentialPoint = Point{ p.x - 1, p.y };
+                potentialPoint = p + GridPos::west;
                 if (isConnectedTo(potentialPoint, p))
                 {
                     result.push_back(potentialPoint);
                 }
             }
 
-            if (p.x < width - 1)
+            if (p.x() < width - 1)
             {
-                potentialPoint = Point{ p.x + 1, p.y };
+                potentialPoint = p + GridPos::east;
                 if (isConnectedTo(potentialPoint, p))
                 {
                     result.push_back(potentialPoint);
                 }
             }
 
-            if (p.y > 0)
+            if (p.y() > 0)
             {
-                potentialPoint = Point{ p.x, p.y - 1 };
+                potentialPoint = p + GridPos::north;
                 if (isConnectedTo(potentialPoint, p))
                 {
                     result.push_back(potentialPoint);
                 }
             }
 
-            if (p.y < height - 1)
+            if (p.y() < height - 1)
             {
-                potentialPoint = Point{ p.x, p.y + 1 };
+                potentialPoint = p + GridPos::south;
                 if (isConnectedTo(potentialPoint, p))
                 {
                     result.push_back(potentialPoint);
@@ -242,10 +226,10 @@ namespace day10
             bool connectedSouth{};
             bool connectedWest{};
 
-            const Point toNorth{ point.x, point.y - 1 };
-            const Point toEast{ point.x + 1, point.y };
-            const Point toSouth{ point.x, point.y + 1 };
-            const Point toWest{ point.x - 1, point.y };
+            const Point toNorth{ point + GridPos::north };
+            const Point toEast{ point + GridPos::east };
+            const Point toSouth{ point + GridPos::south };
+            const Point toWest{ point + GridPos::west };
 
             if (toNorth == path[0] || toNorth == path[2])
             {
@@ -296,7 +280,7 @@ namespace day10
 
             for (auto p : path)
             {
-                isOnPath[p.y][p.x] = true;
+                isOnPath[p.y()][p.x()] = true;
             }
 
             std::cout << '\n';
@@ -319,12 +303,12 @@ namespace day10
 
             for (auto p : path)
             {
-                isOnPath[p.y][p.x] = true;
+                isOnPath[p.y()][p.x()] = true;
             }
 
             for (auto p : enclosed)
             {
-                isEnclosed[p.y][p.x] = true;
+                isEnclosed[p.y()][p.x()] = true;
             }
 
             std::cout << '\n';
@@ -340,7 +324,7 @@ namespace day10
         }
     };
 
-    PipeMap parseInput(std::ifstream& file)
+    PipeMap parseInput(std::istream& file)
     {
         std::vector<std::string> lines{};
         while(!file.eof())
@@ -353,14 +337,14 @@ namespace day10
         return PipeMap{ lines };
     }
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         const auto map{ parseInput(file) };
         const auto path{ map.getPathFromStartingPoint() };
         return static_cast<long long>(path.size()) / 2;
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         const auto map{ parseInput(file) };
         const auto path{ map.getPathFromStartingPoint() };
@@ -378,7 +362,7 @@ namespace day10
 
         for (auto p : path)
         {
-            isOnPath[p.y][p.x] = true;
+            isOnPath[p.y()][p.x()] = true;
         }
 
         long long nrEnclosed{};
@@ -396,10 +380,10 @@ namespace day10
 
                 std::vector<Point> intersectPoints{};
                 Point p{ x, y };
-                while (p.y > 0)
+                while (p.y() > 0)
                 {
-                    p = Point{ p.x, p.y - 1 };
-                    if (isOnPath[p.y][p.x])
+                    p = p + GridPos::north;
+                    if (isOnPath[p.y()][p.x()])
                     {
                         intersectPoints.push_back(p);
                     }
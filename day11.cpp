@@ -11,9 +11,6 @@
 
 namespace day11
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 11 " << (example ? "(example)" : "") << '\n';
@@ -37,7 +34,7 @@ namespace day11
         int originalY{};
     };
 
-    std::vector<Galaxy> parseInput(std::ifstream& file)
+    std::vector<Galaxy> parseInput(std::istream& file)
     {
         std::vector<Galaxy> result{};
         int y{};
@@ -100,7 +97,7 @@ namespace day11
         }
     }
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         auto galaxies{ parseInput(file) };
         expandGalaxies(galaxies, 2);
@@ -118,7 +115,7 @@ namespace day11
         return distanceSum;
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         // Same as part 1, but just different amount added to x/y when expanding.
         auto galaxies{ parseInput(file) };
@@ -1,8 +1,10 @@
 #include "day12.h"
 #include "helpers.h"
+#include "scheduler.h"
 
 #include <cassert>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <ranges>
 #include <string>
@@ -11,9 +13,6 @@
 
 namespace day12
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 12 " << (example ? "(example)" : "") << '\n';
@@ -208,7 +207,7 @@ namespace day12
         return Puzzle{ conditions, groupsAsSymbolString };
     }
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         long long sum{};
 
@@ -224,19 +223,23 @@ namespace day12
         return sum;
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
-        long long sum{};
-
+        std::vector<std::string> lines{};
         while (!file.eof())
         {
             std::string line;
             std::getline(file, line);
-
-            auto puzzle = parseInputToPuzzlePartTwo(line);
-            sum += puzzle.determineOptionsForPuzzle(State{ false, 0, 0 });
+            lines.push_back(line);
         }
 
-        return sum;
+        // Each line is an independent puzzle with its own lookup, so solve them in parallel.
+        return scheduler::parallel_reduce(0, lines.size(), 0LL,
+            [&lines](const size_t i)
+            {
+                auto puzzle = parseInputToPuzzlePartTwo(lines[i]);
+                return puzzle.determineOptionsForPuzzle(State{ false, 0, 0 });
+            },
+            std::plus<long long>{});
     }
 }
\ No newline at end of file
@@ -11,9 +11,6 @@
 
 namespace day13
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 13 " << (example ? "(example)" : "") << '\n';
@@ -100,7 +97,7 @@ namespace day13
         }
     };
 
-    std::vector<Field> parseInput(std::ifstream& file)
+    std::vector<Field> parseInput(std::istream& file)
     {
         std::vector<Field> fields{};
         Field field{ std::vector<std::vector<bool>>{} };
@@ -173,7 +170,7 @@ namespace day13
         return 0;
     }
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         const auto fields = parseInput(file);
         long long sum{};
@@ -186,7 +183,7 @@ namespace day13
         return sum;
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         const auto fields = parseInput(file);
         long long sum{};
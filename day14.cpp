@@ -11,9 +11,6 @@
 
 namespace day14
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 14 " << (example ? "(example)" : "") << '\n';
@@ -235,7 +232,7 @@ namespace day14
         }
     };
 
-    Platform parseInput(std::ifstream& file)
+    Platform parseInput(std::istream& file)
     {
         std::string line;
         std::vector<std::vector<Rock>> field{};
@@ -268,7 +265,7 @@ namespace day14
         return Platform{ field };
     }
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         auto platform = parseInput(file);
         platform.rollNorth();
@@ -276,7 +273,7 @@ namespace day14
         return platform.scoreNorthWeight();
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         auto platform = parseInput(file);
 
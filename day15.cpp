@@ -11,9 +11,6 @@
 
 namespace day15
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 15 " << (example ? "(example)" : "") << '\n';
@@ -91,7 +88,7 @@ namespace day15
         }
     };
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         std::string input;
         std::getline(file, input);
@@ -107,7 +104,7 @@ namespace day15
         return sum;
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         std::string input;
         std::getline(file, input);
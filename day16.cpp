@@ -1,8 +1,12 @@
 #include "day16.h"
+#include "bitmap.h"
+#include "grid.h"
 #include "helpers.h"
+#include "scheduler.h"
 
-#include <array>
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <fstream>
 #include <list>
 #include <iostream>
@@ -13,9 +17,6 @@
 
 namespace day16
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 16 " << (example ? "(example)" : "") << '\n';
@@ -31,7 +32,7 @@ namespace day16
         std::cout << "Part 2 answer: " << solvePart2(file) << '\n';
     }
 
-    enum class Direction
+    enum class Direction : std::uint8_t
     {
         north,
         east,
@@ -42,26 +43,12 @@ namespace day16
 
     struct Beam
     {
-        size_t x;
-        size_t y;
+        GridPos pos;
         Direction dir;
 
         void moveStep()
         {
-            switch (dir) {
-            case Direction::north:
-                y--;
-                break;
-            case Direction::east:
-                x++;
-                break;
-            case Direction::south:
-                y++;
-                break;
-            case Direction::west:
-                x--;
-                break;
-            }
+            pos = pos.step(dir);
         }
 
         void updateDirWithCorner(const char corner)
@@ -106,41 +93,23 @@ namespace day16
     struct Field
     {
         std::vector<std::string> field{};
-        // Interesting note: for some reasone writing to this triple nested array
-        // is much faster than updating a vector<vector<bool>> (used to have seperate energized variable).
-
-        std::vector<std::vector<std::array<bool, 4>>> directionPassed;
         size_t width;
         size_t height;
 
+        // Which directions a beam passed each tile in, tile is energized if any are set.
+        StateBitmap<4> directionPassed;
+
         explicit Field(const std::vector<std::string>& f)
+            : field{ f }, width{ f[0].size() }, height{ f.size() }, directionPassed{ width, height }
         {
-            field = f;
-            height = f.size();
-            width = f[0].size();
-            resetField();
         }
 
-        void fireBeam(size_t enterX, size_t enterY, Direction enterDir)
+        void fireBeam(const size_t enterX, const size_t enterY, const Direction enterDir)
         {
             // Offset by one (reversed) step, since loops moves before marking
-            switch (enterDir) {
-            case Direction::north:
-                enterY++;
-                break;
-            case Direction::east:
-                enterX--;
-                break;
-            case Direction::south:
-                enterY--;
-                break;
-            case Direction::west:
-                enterX++;
-                break;
-            }
-
+            const GridPos enterPos{ enterX, enterY };
             std::queue<Beam> beamQueue{};
-            beamQueue.push(Beam{ enterX, enterY, enterDir });
+            beamQueue.push(Beam{ enterPos + (-GridPos::directionOffsets[static_cast<size_t>(enterDir)]), enterDir });
             while (!beamQueue.empty())
             {
                 Beam& b = beamQueue.front();
@@ -149,20 +118,18 @@ namespace day16
                 {
                     b.moveStep();
                     // Use overflow to also monitor for going off low end
-                    if (b.x >= width || b.y >= height)
+                    if (!b.pos.inBounds(width, height))
                     {
                         break;
                     }
 
                     // loop detection
-                    if (directionPassed[b.y][b.x][static_cast<unsigned int>(b.dir)])
+                    if (directionPassed.testAndSet(b.pos.x(), b.pos.y(), b.dir))
                     {
                         break;
                     }
 
-                    directionPassed[b.y][b.x][static_cast<unsigned int>(b.dir)] = true;
-
-                    const char c{ field[b.y][b.x] };
+                    const char c{ field[b.pos.y()][b.pos.x()] };
 
                     if (c == '.')
                     {
@@ -178,7 +145,7 @@ namespace day16
 
                         // Replace b with beams going up & down:
                         b.dir = Direction::north;
-                        beamQueue.push(Beam{ b.x, b.y, Direction::south });
+                        beamQueue.push(Beam{ b.pos, Direction::south });
                         continue;
                     }
 
@@ -191,7 +158,7 @@ namespace day16
 
                         // Replace b with beams going up & down:
                         b.dir = Direction::west;
-                        beamQueue.push(Beam{ b.x, b.y, Direction::east });
+                        beamQueue.push(Beam{ b.pos, Direction::east });
                         continue;
                     }
 
@@ -204,17 +171,17 @@ namespace day16
 
         void resetField()
         {
-            directionPassed = std::vector(height, std::vector(width, std::array<bool, 4>{}));
+            directionPassed.clear();
         }
 
         void printEnergized() const
         {
             std::cout << '\n';
-            for (const auto& row : directionPassed)
+            for (size_t y = 0; y < height; y++)
             {
-                for (const auto b : row)
+                for (size_t x = 0; x < width; x++)
                 {
-                    if (std::ranges::any_of(b, [](bool b){return b;}))
+                    if (directionPassed.cellHasAnyState(x, y))
                     {
                         std::cout << '#';
                     }
@@ -230,27 +197,11 @@ namespace day16
 
         [[nodiscard]] long long score() const
         {
-            long long sum{};
-            for (const auto& row : directionPassed)
-            {
-                for (const auto b : row)
-                {
-                    for (size_t i = 0; i < 4; i++)
-                    {
-                        if (b[i])
-                        {
-                            sum++;
-                            break;
-                        }
-                    }
-                }
-            }
-
-            return sum;
+            return static_cast<long long>(directionPassed.countCellsWithAnyState());
         }
     };
 
-    Field parseInput(std::ifstream& file)
+    Field parseInput(std::istream& file)
     {
         std::vector<std::string> field{};
         while(!file.eof())
@@ -263,7 +214,7 @@ namespace day16
         return Field( field );
     }
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         auto field{ parseInput(file) };
         field.fireBeam(0, 0, Direction::east);
@@ -271,34 +222,32 @@ namespace day16
         return field.score();
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
-        auto field{ parseInput(file) };
-        long long maxScore{};
-        // Loop over left & right side:
+        const auto field{ parseInput(file) };
+
+        // Collect all entry beams, left & right side first, then top & bottom side:
+        std::vector<Beam> entryBeams{};
         for (size_t y = 0; y < field.height; y++)
         {
-            field.resetField();
-            field.fireBeam(0, y, Direction::east);
-            maxScore = std::max(maxScore, field.score());
-
-            field.resetField();
-            field.fireBeam(field.width - 1, y, Direction::west);
-            maxScore = std::max(maxScore, field.score());
+            entryBeams.push_back(Beam{ GridPos{ 0, y }, Direction::east });
+            entryBeams.push_back(Beam{ GridPos{ field.width - 1, y }, Direction::west });
         }
 
-        // Loop over top & bottom side:
-        for (size_t x = 0; x < field.width ; x++)
+        for (size_t x = 0; x < field.width; x++)
         {
-            field.resetField();
-            field.fireBeam(x, 0, Direction::south);
-            maxScore = std::max(maxScore, field.score());
-
-            field.resetField();
-            field.fireBeam(x, field.height - 1, Direction::north);
-            maxScore = std::max(maxScore, field.score());
+            entryBeams.push_back(Beam{ GridPos{ x, 0 }, Direction::south });
+            entryBeams.push_back(Beam{ GridPos{ x, field.height - 1 }, Direction::north });
         }
 
-        return maxScore;
+        // Fire the beams in parallel, each on its own copy of the field.
+        return scheduler::parallel_reduce(0, entryBeams.size(), 0LL,
+            [&field, &entryBeams](const size_t i)
+            {
+                Field beamField{ field.field };
+                beamField.fireBeam(entryBeams[i].pos.x(), entryBeams[i].pos.y(), entryBeams[i].dir);
+                return beamField.score();
+            },
+            [](const long long a, const long long b) { return std::max(a, b); });
     }
 }
\ No newline at end of file
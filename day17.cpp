@@ -1,8 +1,10 @@
 #include "day17.h"
+#include "bitmap.h"
+#include "grid.h"
 #include "helpers.h"
 
-#include <array>
 #include <cassert>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <ranges>
@@ -12,9 +14,6 @@
 
 namespace day17
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 17 " << (example ? "(example)" : "") << '\n';
@@ -30,7 +29,7 @@ namespace day17
         std::cout << "Part 2 answer: " << solvePart2(file) << '\n';
     }
 
-    enum class Direction
+    enum class Direction : std::uint8_t
     {
         north,
         east,
@@ -38,28 +37,25 @@ namespace day17
         west
     };
 
+    // Kept small (16 bytes) since lots of these pass through the priority queue.
     struct State
     {
-        size_t x{};
-        size_t y{};
-        int nrMovedStraight{};
+        GridPos pos{};
+        std::uint8_t nrMovedStraight{};
         Direction lastDirection{};
         int costSoFar{};
-        size_t heuristicScore{};
+        int heuristicScore{};
 
-        [[nodiscard]] auto calculateHeuristicScore(const size_t goalX, const size_t goalY) const
-        {
-            return costSoFar + (goalX - x) + (goalY - y);
-        }
+        [[nodiscard]] size_t x() const { return pos.x(); }
+        [[nodiscard]] size_t y() const { return pos.y(); }
 
         State(size_t xP, size_t yP, int nrMovedStraightP, Direction lastDirectionP, int costSoFarP, size_t goalX, size_t goalY)
         {
-            x = xP;
-            y = yP;
-            nrMovedStraight = nrMovedStraightP;
+            pos = GridPos{ xP, yP };
+            nrMovedStraight = static_cast<std::uint8_t>(nrMovedStraightP);
             lastDirection = lastDirectionP;
             costSoFar = costSoFarP;
-            heuristicScore = calculateHeuristicScore(goalX, goalY);
+            heuristicScore = costSoFar + static_cast<int>((goalX - xP) + (goalY - yP));
         }
     };
 
@@ -69,7 +65,7 @@ namespace day17
         size_t width;
         size_t height;
 
-        explicit City(std::ifstream& file)
+        explicit City(std::istream& file)
         {
             map = std::vector<std::vector<int>>{};
             while(!file.eof())
@@ -90,7 +86,7 @@ namespace day17
 
         [[nodiscard]] auto heuristicScoreState(const State& s) const
         {
-            return (width - s.x - 1) + (height - s.y - 1);
+            return (width - s.x() - 1) + (height - s.y() - 1);
         }
     };
 
@@ -102,9 +98,8 @@ namespace day17
         const size_t goalY{ city.height - 1 };
         const State startPos{ 0, 0, 0, Direction::east, 0, goalX, goalY };
 
-        // To keep track of passed states
-        // bool, 16 array for nrMovedStraight * 4 + direction.
-        std::vector passed(city.height, std::vector(city.width, std::array<bool, 16>{}));
+        // To keep track of passed states, per position by nrMovedStraight (0-3) & direction.
+        StateBitmap<4, 4> passed{ city.width, city.height };
 
 
         auto cmp = [](const State l, const State r) { return l.heuristicScore > r.heuristicScore; };
@@ -116,83 +111,85 @@ namespace day17
             State s{ statePriorityQueue.top() };
             statePriorityQueue.pop();
 
-            const auto directionIndex = s.nrMovedStraight * 4LL + (static_cast<size_t>(s.lastDirection));
-            if (passed[s.y][s.x][directionIndex])
+            if (!statePriorityQueue.empty())
             {
-                continue;
+                passed.prefetch(statePriorityQueue.top().x(), statePriorityQueue.top().y());
             }
 
-            passed[s.y][s.x][directionIndex] = true;
+            if (passed.testAndSet(s.x(), s.y(), s.nrMovedStraight, s.lastDirection))
+            {
+                continue;
+            }
 
-            if (s.y == goalY && s.x == goalX)
+            if (s.y() == goalY && s.x() == goalX)
             {
                 return s.costSoFar;
             }
 
-            if (s.y > 0 && s.lastDirection != Direction::south)
+            if (s.y() > 0 && s.lastDirection != Direction::south)
             {
                 if (s.lastDirection == Direction::north)
                 {
                     if (s.nrMovedStraight < 3)
                     {
-                        State newState{ s.x, s.y - 1, s.nrMovedStraight + 1, Direction::north, s.costSoFar + city.map[s.y - 1][s.x], goalX, goalY };
+                        State newState{ s.x(), s.y() - 1, s.nrMovedStraight + 1, Direction::north, s.costSoFar + city.map[s.y() - 1][s.x()], goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
                 else
                 {
-                    State newState{ s.x, s.y - 1, 1, Direction::north, s.costSoFar + city.map[s.y - 1][s.x], goalX, goalY };
+                    State newState{ s.x(), s.y() - 1, 1, Direction::north, s.costSoFar + city.map[s.y() - 1][s.x()], goalX, goalY };
                     statePriorityQueue.push(newState);
                 }
             }
 
-            if (s.y < goalY && s.lastDirection != Direction::north)
+            if (s.y() < goalY && s.lastDirection != Direction::north)
             {
                 if (s.lastDirection == Direction::south)
                 {
                     if (s.nrMovedStraight < 3)
                     {
-                        State newState{ s.x, s.y + 1, s.nrMovedStraight + 1, Direction::south, s.costSoFar + city.map[s.y + 1][s.x], goalX, goalY };
+                        State newState{ s.x(), s.y() + 1, s.nrMovedStraight + 1, Direction::south, s.costSoFar + city.map[s.y() + 1][s.x()], goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
                 else
                 {
-                    State newState{ s.x, s.y + 1, 1, Direction::south, s.costSoFar + city.map[s.y + 1][s.x], goalX, goalY };
+                    State newState{ s.x(), s.y() + 1, 1, Direction::south, s.costSoFar + city.map[s.y() + 1][s.x()], goalX, goalY };
                     statePriorityQueue.push(newState);
                 }
             }
 
-            if (s.x > 0 && s.lastDirection != Direction::east)
+            if (s.x() > 0 && s.lastDirection != Direction::east)
             {
                 if (s.lastDirection == Direction::west)
                 {
                     if (s.nrMovedStraight < 3)
                     {
-                        State newState{ s.x - 1, s.y, s.nrMovedStraight + 1, Direction::west, s.costSoFar + city.map[s.y][s.x - 1], goalX, goalY };
+                        State newState{ s.x() - 1, s.y(), s.nrMovedStraight + 1, Direction::west, s.costSoFar + city.map[s.y()][s.x() - 1], goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
                 else
                 {
-                    State newState{ s.x - 1, s.y, 1, Direction::west, s.costSoFar + city.map[s.y][s.x - 1], goalX, goalY };
+                    State newState{ s.x() - 1, s.y(), 1, Direction::west, s.costSoFar + city.map[s.y()][s.x() - 1], goalX, goalY };
                     statePriorityQueue.push(newState);
                 }
             }
 
-            if (s.x < goalX && s.lastDirection != Direction::west)
+            if (s.x() < goalX && s.lastDirection != Direction::west)
             {
                 if (s.lastDirection == Direction::east)
                 {
                     if (s.nrMovedStraight < 3)
                     {
-                        State newState{ s.x + 1, s.y, s.nrMovedStraight + 1, Direction::east, s.costSoFar + city.map[s.y][s.x + 1], goalX, goalY };
+                        State newState{ s.x() + 1, s.y(), s.nrMovedStraight + 1, Direction::east, s.costSoFar + city.map[s.y()][s.x() + 1], goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
                 else
                 {
-                    State newState{ s.x + 1, s.y, 1, Direction::east, s.costSoFar + city.map[s.y][s.x + 1], goalX, goalY };
+                    State newState{ s.x() + 1, s.y(), 1, Direction::east, s.costSoFar + city.map[s.y()][s.x() + 1], goalX, goalY };
                     statePriorityQueue.push(newState);
                 }
             }
@@ -213,9 +210,8 @@ namespace day17
         const size_t goalY{ city.height - 1 };
         const State startPos{ 0, 0, 0, Direction::east, 0, goalX, goalY };
 
-        // To keep track of passed states
-        // bool, 44 array for nrMovedStraight * 4 + direction.
-        std::vector passed(city.height, std::vector(city.width, std::array<bool, 44>{}));
+        // To keep track of passed states, per position by nrMovedStraight (0-10) & direction.
+        StateBitmap<11, 4> passed{ city.width, city.height };
 
 
         auto cmp = [](const State l, const State r) { return l.heuristicScore > r.heuristicScore; };
@@ -227,117 +223,119 @@ namespace day17
             State s{ statePriorityQueue.top() };
             statePriorityQueue.pop();
 
-            const auto directionIndex = s.nrMovedStraight * 4LL + (static_cast<size_t>(s.lastDirection));
-            if (passed[s.y][s.x][directionIndex])
+            if (!statePriorityQueue.empty())
             {
-                continue;
+                passed.prefetch(statePriorityQueue.top().x(), statePriorityQueue.top().y());
             }
 
-            passed[s.y][s.x][directionIndex] = true;
+            if (passed.testAndSet(s.x(), s.y(), s.nrMovedStraight, s.lastDirection))
+            {
+                continue;
+            }
 
-            if (s.y == goalY && s.x == goalX && s.nrMovedStraight >= 4)
+            if (s.y() == goalY && s.x() == goalX && s.nrMovedStraight >= 4)
             {
                 return s.costSoFar;
             }
 
-            if (s.y > 0 && s.lastDirection != Direction::south)
+            if (s.y() > 0 && s.lastDirection != Direction::south)
             {
                 if (s.lastDirection == Direction::north)
                 {
                     if (s.nrMovedStraight < 10)
                     {
-                        State newState{ s.x, s.y - 1, s.nrMovedStraight + 1, Direction::north, s.costSoFar + city.map[s.y - 1][s.x], goalX, goalY };
+                        State newState{ s.x(), s.y() - 1, s.nrMovedStraight + 1, Direction::north, s.costSoFar + city.map[s.y() - 1][s.x()], goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
                 else
                 {
-                    if (s.nrMovedStraight >= 4 && s.y > 3)
+                    if (s.nrMovedStraight >= 4 && s.y() > 3)
                     {
                         int costSoFar{ s.costSoFar };
                         for(int i =1; i <= 4; i++)
                         {
-                            costSoFar += city.map[s.y - i][s.x];
+                            costSoFar += city.map[s.y() - i][s.x()];
                         }
-                        State newState{ s.x, s.y - 4, 4, Direction::north, costSoFar, goalX, goalY };
+                        State newState{ s.x(), s.y() - 4, 4, Direction::north, costSoFar, goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
             }
 
-            if (s.y < goalY && s.lastDirection != Direction::north)
+            if (s.y() < goalY && s.lastDirection != Direction::north)
             {
                 if (s.lastDirection == Direction::south)
                 {
                     if (s.nrMovedStraight < 10)
                     {
-                        State newState{ s.x, s.y + 1, s.nrMovedStraight + 1, Direction::south, s.costSoFar + city.map[s.y + 1][s.x], goalX, goalY };
+                        State newState{ s.x(), s.y() + 1, s.nrMovedStraight + 1, Direction::south, s.costSoFar + city.map[s.y() + 1][s.x()], goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
                 else
                 {
-                    if (s.nrMovedStraight >= 4 && s.y < goalY - 3)
+                    if (s.nrMovedStraight >= 4 && s.y() < goalY - 3)
                     {
                         int costSoFar{ s.costSoFar };
                         for (int i = 1; i <= 4; i++)
                         {
-                            costSoFar += city.map[s.y + i][s.x];
+                            costSoFar += city.map[s.y() + i][s.x()];
                         }
 
-                        State newState{ s.x, s.y + 4, 4, Direction::south, costSoFar, goalX, goalY };
+                        State newState{ s.x(), s.y() + 4, 4, Direction::south, costSoFar, goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
             }
 
-            if (s.x > 0 && s.lastDirection != Direction::east)
+            if (s.x() > 0 && s.lastDirection != Direction::east)
             {
                 if (s.lastDirection == Direction::west)
                 {
                     if (s.nrMovedStraight < 10)
                     {
-                        State newState{ s.x - 1, s.y, s.nrMovedStraight + 1, Direction::west, s.costSoFar + city.map[s.y][s.x - 1], goalX, goalY };
+                        State newState{ s.x() - 1, s.y(), s.nrMovedStraight + 1, Direction::west, s.costSoFar + city.map[s.y()][s.x() - 1], goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
                 else
                 {
-                    if (s.nrMovedStraight >= 4 && s.x > 3)
+                    if (s.nrMovedStraight >= 4 && s.x() > 3)
                     {
                         int costSoFar{ s.costSoFar };
                         for (int i = 1; i <= 4; i++)
                         {
-                            costSoFar += city.map[s.y][s.x - i];
+                            costSoFar += city.map[s.y()][s.x() - i];
                         }
 
-                        State newState{ s.x - 4, s.y, 4, Direction::west, costSoFar, goalX, goalY };
+                        State newState{ s.x() - 4, s.y(), 4, Direction::west, costSoFar, goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
             }
 
-            if (s.x < goalX && s.lastDirection != Direction::west)
+            if (s.x() < goalX && s.lastDirection != Direction::west)
             {
                 if (s.lastDirection == Direction::east)
                 {
                     if (s.nrMovedStraight < 10)
                     {
-                        State newState{ s.x + 1, s.y, s.nrMovedStraight + 1, Direction::east, s.costSoFar + city.map[s.y][s.x + 1], goalX, goalY };
+                        State newState{ s.x() + 1, s.y(), s.nrMovedStraight + 1, Direction::east, s.costSoFar + city.map[s.y()][s.x() + 1], goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
                 else
                 {
-                    if (s.nrMovedStraight >= 4 && s.x < goalX - 3)
+                    if (s.nrMovedStraight >= 4 && s.x() < goalX - 3)
                     {
                         int costSoFar{ s.costSoFar };
                         for (int i = 1; i <= 4; i++)
                         {
-                            costSoFar += city.map[s.y][s.x + i];
+                            costSoFar += city.map[s.y()][s.x() + i];
                         }
 
-                        State newState{ s.x + 4, s.y, 4, Direction::east, costSoFar, goalX, goalY };
+                        State newState{ s.x() + 4, s.y(), 4, Direction::east, costSoFar, goalX, goalY };
                         statePriorityQueue.push(newState);
                     }
                 }
@@ -349,13 +347,13 @@ namespace day17
         return 0;
     }
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         const City city(file);
         return determineShortestPathLength(city);
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         const City city(file);
         return determineShortestPathLengthForUltraCrucible(city);
@@ -14,9 +14,6 @@
 
 namespace day18
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 18 " << (example ? "(example)" : "") << '\n';
@@ -112,7 +109,7 @@ namespace day18
             return Instruction{ d, dist };
         }
 
-        void loadPart1Input(std::ifstream& file)
+        void loadPart1Input(std::istream& file)
         {
             instructions = std::vector<Instruction>{};
             while (!file.eof())
@@ -162,7 +159,7 @@ namespace day18
             }
         }
 
-        void loadPart2Input(std::ifstream& file)
+        void loadPart2Input(std::istream& file)
         {
             instructions = std::vector<Instruction>{};
             while (!file.eof())
@@ -483,7 +480,7 @@ namespace day18
         }
     };
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         Input input{};
         input.loadPart1Input(file);
@@ -492,7 +489,7 @@ namespace day18
         return trench.scoreOnSections();
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         Input input{};
         input.loadPart2Input(file);
@@ -1,6 +1,10 @@
 #pragma once
+#include <istream>
+
 namespace day18
 {
     void run_day(bool example);
+    long long solvePart1(std::istream& file);
+    long long solvePart2(std::istream& file);
     void test_part2();
 }
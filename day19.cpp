@@ -15,9 +15,6 @@
 
 namespace day19
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 19 " << (example ? "(example)" : "") << '\n';
@@ -161,7 +158,7 @@ namespace day19
         std::vector<Part> acceptedParts{};
         std::vector<RatingsRegion> acceptedRatingRegions{};
 
-        void parseInput(std::ifstream& file)
+        void parseInput(std::istream& file)
         {
             std::string line;
             std::getline(file, line);
@@ -326,7 +323,7 @@ namespace day19
         }
     };
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         Puzzle puzzle{};
         puzzle.parseInput(file);
@@ -334,7 +331,7 @@ namespace day19
         return puzzle.scoreAcceptedParts();
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         Puzzle puzzle{};
         puzzle.parseInput(file);
@@ -16,9 +16,6 @@
 
 namespace day20
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 20 " << (example ? "(example)" : "") << '\n';
@@ -159,7 +156,7 @@ namespace day20
     {
         std::unordered_map<std::string, Module> moduleLookup{};
 
-        void parseInput(std::ifstream& file)
+        void parseInput(std::istream& file)
         {
             while(!file.eof())
             {
@@ -282,14 +279,14 @@ namespace day20
     };
 
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         System system{};
         system.parseInput(file);
         return system.scoreButtonPresses(1000);
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         System system{};
         system.parseInput(file);
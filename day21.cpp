@@ -1,9 +1,12 @@
 #include "day21.h"
+#include "bitmap.h"
+#include "grid.h"
 #include "helpers.h"
 
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <numeric>
@@ -16,9 +19,6 @@
 
 namespace day21
 {
-    long long solvePart1(std::ifstream& file, bool example);
-    long long solvePart2(std::ifstream& file, bool example);
-
     void run_day(bool example)
     {
         std::cout << "Running day 21 " << (example ? "(example)" : "") << '\n';
@@ -43,22 +43,13 @@ namespace day21
         }
     }
 
-    struct Point
-    {
-        size_t x{};
-        size_t y{};
-
-        [[nodiscard]] Point operator+(const Point& other) const
-        {
-            return Point{ x + other.x, y + other.y };
-        }
-    };
+    using Point = GridPos;
 
-    std::array<Point, 4> directionOffsets{
-        Point(-1, 0),
-        Point(1, 0),
-        Point(0, -1),
-        Point(0, 1)
+    std::array<std::int32_t, 4> directionOffsets{
+        GridPos::west,
+        GridPos::east,
+        GridPos::north,
+        GridPos::south
     };
 
     struct WalkState
@@ -70,7 +61,6 @@ namespace day21
     struct Garden
     {
         std::vector<std::vector<bool>> gardenPlots{};
-        std::vector<std::vector<int>> nrOfStepsNeeded{};
 
         size_t width;
         size_t height;
@@ -78,7 +68,7 @@ namespace day21
         size_t startX;
         size_t startY;
 
-        void parseInput(std::ifstream& file)
+        void parseInput(std::istream& file)
         {
             size_t y{};
             while(!file.eof())
@@ -106,33 +96,43 @@ namespace day21
 
             width = gardenPlots[0].size();
             height = gardenPlots.size();
-
-            nrOfStepsNeeded = std::vector(height, std::vector(width, -1));
         }
 
-        // Simple breadth first fill out of (bounded) min steps
-        void fillOutStepsNeeded()
+        // Simple breadth first fill out of (bounded) min steps, counting the gardens reached on the right parity as we go.
+        // Can always 'skip' two steps by walking back and forth, so anything reached within nrOfSteps is
+        // reachable at nrOfSteps if matches %2.
+        [[nodiscard]] long long scoreNrOfGardensPartOne(const int nrOfSteps) const
         {
+            StateBitmap<> reached{ width, height };
+            long long sum{};
+
             std::queue<WalkState> queue{};
             queue.emplace(Point{ startX, startY }, 0);
             while(!queue.empty())
             {
                 const WalkState& w{ queue.front() };
 
-                if(nrOfStepsNeeded[w.p.y][w.p.x] >= 0)
+                if (w.stepsTaken > nrOfSteps)
+                {
+                    break;
+                }
+
+                if(reached.testAndSet(w.p.x(), w.p.y()))
                 {
                     queue.pop();
                     continue;
                 }
 
-                nrOfStepsNeeded[w.p.y][w.p.x] = w.stepsTaken;
+                if (w.stepsTaken % 2 == nrOfSteps % 2)
+                {
+                    sum++;
+                }
 
                 for (const auto& directionOffset : directionOffsets)
                 {
                     Point newPoint{ w.p + directionOffset };
                     // Using overflow to check for lower bound
-                    if (newPoint.x < width && newPoint.y < height
-                        && gardenPlots[newPoint.y][newPoint.x])
+                    if (newPoint.inBounds(width, height) && gardenPlots[newPoint.y()][newPoint.x()])
                     {
                         queue.emplace(newPoint, w.stepsTaken + 1);
                     }
@@ -140,13 +140,16 @@ namespace day21
 
                 queue.pop();
             }
+
+            return sum;
         }
 
-        long long partTwoBreadthFirstScore(const long long nrOfSteps)
+        [[nodiscard]] long long partTwoBreadthFirstScore(const long long nrOfSteps) const
         {
             // Horrible ugly solution generating extended map
             const auto nrOfExtraCopies{ (nrOfSteps + (width/2)) / width };
-            std::vector nrOfStepsNeededWithCopies(height * (1 + 2 * nrOfExtraCopies), std::vector(width * (1 + 2 * nrOfExtraCopies), -1));
+            StateBitmap<> reachedWithCopies{ width * (1 + 2 * nrOfExtraCopies), height * (1 + 2 * nrOfExtraCopies) };
+            long long sum{};
 
             std::queue<WalkState> queue{};
             // start offset by nrOfExtraCopies copies on x & y
@@ -160,20 +163,23 @@ namespace day21
                     break;
                 }
 
-                if (nrOfStepsNeededWithCopies[w.p.y][w.p.x] >= 0)
+                if (reachedWithCopies.testAndSet(w.p.x(), w.p.y()))
                 {
                     queue.pop();
                     continue;
                 }
 
-                nrOfStepsNeededWithCopies[w.p.y][w.p.x] = w.stepsTaken;
+                if (w.stepsTaken % 2 == (nrOfSteps % 2))
+                {
+                    sum++;
+                }
 
                 for (const auto& directionOffset : directionOffsets)
                 {
                     // note skipping over logic for edge walking here since we added extra copies anyway
                     Point newPoint{ w.p + directionOffset };
 
-                    if (gardenPlots[newPoint.y % height][newPoint.x % width])
+                    if (gardenPlots[newPoint.y() % height][newPoint.x() % width])
                     {
                         queue.emplace(newPoint, w.stepsTaken + 1);
                     }
@@ -182,58 +188,19 @@ namespace day21
                 queue.pop();
             }
 
-
-            long long sum{};
-            for (const auto& row : nrOfStepsNeededWithCopies)
-            {
-                for (const auto r : row)
-                {
-                    if (r % 2 == (nrOfSteps % 2))
-                    {
-                        sum++;
-                    }
-                }
-            }
-
-            return sum;
-        }
-
-        [[nodiscard]] long long scoreNrOfGardensPartOne(const int nrOfSteps) const
-        {
-            long long sum{};
-            for (size_t y = 0; y < height; y++)
-            {
-                for (size_t x = 0; x < width; x++)
-                {
-                    if (!gardenPlots[y][x])
-                    {
-                        continue;
-                    }
-
-                    const auto steps{ nrOfStepsNeeded[y][x] };
-                    // Can always 'skip' two steps by walking back and forth, so anything
-                    // below nrOfSteps is reachable if matches %2.
-                    if (steps <= nrOfSteps && (steps % 2) == (nrOfSteps % 2))
-                    {
-                        sum++;
-                    }
-                }
-            }
-
             return sum;
         }
     };
 
-    long long solvePart1(std::ifstream& file, bool example)
+    long long solvePart1(std::istream& file, bool example)
     {
         Garden garden{};
         garden.parseInput(file);
-        garden.fillOutStepsNeeded();
 
         return garden.scoreNrOfGardensPartOne(example ? 6 : 64);
     }
 
-    long long solvePart2(std::ifstream& file, bool example)
+    long long solvePart2(std::istream& file, bool example)
     {
         Garden garden{};
         garden.parseInput(file);
@@ -1,9 +1,11 @@
 #include "day22.h"
 #include "helpers.h"
+#include "scheduler.h"
 
 #include <algorithm>
 #include <cassert>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <unordered_map>
 #include <ranges>
@@ -12,9 +14,6 @@
 
 namespace day22
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 22 " << (example ? "(example)" : "") << '\n';
@@ -167,7 +166,7 @@ namespace day22
 
         std::vector<std::vector<std::vector<bool>>> occupiedCoordinateLookup{};
 
-        void parseInput(std::ifstream& file)
+        void parseInput(std::istream& file)
         {
             int index{};
             while(!file.eof())
@@ -298,7 +297,8 @@ namespace day22
             return true;
         }
 
-        [[nodiscard]] long long determineNumberOfBricksDroppedByRemoval(const Brick& b)
+        // Expects restingBricks to be sorted by lowest z.
+        [[nodiscard]] long long determineNumberOfBricksDroppedByRemoval(const Brick& b) const
         {
             // Naive implementation that reruns dropping algorithm for all bricks after removal
             // Determine ranges for the occupied lookup
@@ -315,9 +315,6 @@ namespace day22
             // Keep track of which blocks occupies each coordinate (if any)
             auto occupiedLookup = std::vector(maxX + 1, std::vector(maxY + 1, std::vector(maxZ + 1, false)));
 
-            // Sort the resting bricks
-            std::ranges::sort(restingBricks, [](const Brick& b1, const Brick& b2) {return b1.lowestZ() < b2.lowestZ(); });
-
             // Check if any brick now can drop more than it's current position
             long long nrDropped{};
             for (Brick restingBrick : restingBricks)
@@ -383,18 +380,16 @@ namespace day22
 
         [[nodiscard]] long long determineNumberOfTotalBricksDropped()
         {
+            // Sort the resting bricks once up front, so each removal can be simulated independently in parallel.
+            std::ranges::sort(restingBricks, [](const Brick& b1, const Brick& b2) {return b1.lowestZ() < b2.lowestZ(); });
 
-            long long nr{};
-            for (const auto& restingBrick : restingBricks)
-            {
-                nr += determineNumberOfBricksDroppedByRemoval(restingBrick);
-            }
-
-            return nr;
+            return scheduler::parallel_reduce(0, restingBricks.size(), 0LL,
+                [this](const size_t i) { return determineNumberOfBricksDroppedByRemoval(restingBricks[i]); },
+                std::plus<long long>{});
         }
     };
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         Puzzle puzzle{};
         puzzle.parseInput(file);
@@ -402,7 +397,7 @@ namespace day22
         return puzzle.determineNumberOfSafeBricksToDrop();
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         Puzzle puzzle{};
         puzzle.parseInput(file);
@@ -1,5 +1,9 @@
 #pragma once
+#include <istream>
+
 namespace day22
 {
     void run_day(bool example);
+    long long solvePart1(std::istream& file);
+    long long solvePart2(std::istream& file);
 }
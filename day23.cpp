@@ -1,5 +1,8 @@
 #include "day23.h"
+#include "cancellation.h"
+#include "checkpoint.h"
 #include "helpers.h"
+#include "scheduler.h"
 
 #include <algorithm>
 #include <array>
@@ -7,15 +10,13 @@
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <vector>
 
 namespace day23
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 23 " << (example ? "(example)" : "") << '\n';
@@ -85,7 +86,7 @@ namespace day23
         int height{};
         int width{};
 
-        void parseInput(std::ifstream& file)
+        void parseInput(std::istream& file)
         {
             while (!file.eof())
             {
@@ -126,6 +127,8 @@ namespace day23
 
         [[nodiscard]] long long findLongestFromPoint(Point p) const
         {
+            cancellation::checkpoint();
+
             // Assumption here:
             // After split/start we're always in a spot with 1 adjacent '.' square
             // Follow this finding one new adjacent '.' every step, till we reach a
@@ -261,7 +264,7 @@ namespace day23
         std::unordered_map<size_t, Intersection> intersectionLookupByIndex{};
         size_t intersectionIndex{};
 
-        void parseInput(std::ifstream& file)
+        void parseInput(std::istream& file)
         {
             while (!file.eof())
             {
@@ -426,42 +429,124 @@ namespace day23
             long long distance;
         };
 
-        long long findLongestPathStackBased()
+        // Pushes all states reachable in one step from the given state onto the stack,
+        // or updates maxDistanceFound if the state is at the finish.
+        void expandState(const searchState& state, std::vector<searchState>& stateStack, long long& maxDistanceFound) const
         {
-            std::vector<searchState> stateStack{ searchState{0, 1LL << 0, 0LL}};
+            const auto& intersection{ intersectionLookupByIndex.at(state.intersectionIndex) };
+
+            if (intersection.isFinish)
+            {
+                maxDistanceFound = std::max(state.distance, maxDistanceFound);
+                return;
+            }
+
+            for (const auto& [distance, adjacentIntersectIndex] : intersection.adjacentIntersectionIndices)
+            {
+                const long long bitMask{ 1LL << adjacentIntersectIndex };
+                if ((state.passedLookup & bitMask) > 1)
+                {
+                    // already passed in the past of this state
+                    continue;
+                }
+
+                stateStack.emplace_back(
+                    adjacentIntersectIndex,
+                    state.passedLookup | bitMask,
+                    state.distance + distance
+                );
+            }
+        }
+
+        [[nodiscard]] long long findLongestPathFrom(const searchState& startState) const
+        {
+            std::vector<searchState> stateStack{ startState };
             long long maxDistanceFound{};
 
             while(!stateStack.empty())
             {
+                cancellation::checkpoint();
+
                 searchState state{ stateStack.back() };
                 stateStack.pop_back();
+                expandState(state, stateStack, maxDistanceFound);
+            }
 
-                const auto& intersection{ intersectionLookupByIndex[state.intersectionIndex] };
+            return maxDistanceFound;
+        }
 
-                if (intersection.isFinish)
-                {
-                    maxDistanceFound = std::max(state.distance, maxDistanceFound);
-                    continue;
-                }
+        // Subtree of the search, checkpointed with the longest path found in it once it's been searched.
+        struct FrontierEntry
+        {
+            searchState state;
+            bool searched;
+            long long longestPath;
+        };
 
-                for (const auto& [distance, adjacentIntersectIndex] : intersection.adjacentIntersectionIndices)
+        long long findLongestPathStackBased()
+        {
+            // Expand breadth first until there are enough independent subtrees to keep all workers busy,
+            // then search each subtree in parallel.
+            // Searched subtrees are checkpointed, so an interrupted search only redoes the subtrees in progress.
+            std::string allTiles{};
+            for (const auto& row : tiles)
+            {
+                allTiles += row;
+            }
+
+            checkpoint::Checkpoint<long long, FrontierEntry> frontierCheckpoint{ "day23", checkpoint::fingerprint(allTiles) };
+            std::vector<FrontierEntry> frontier{};
+            long long maxDistanceFound{};
+
+            if (!frontierCheckpoint.load(maxDistanceFound, frontier))
+            {
+                const size_t targetFrontierSize{ scheduler::defaultScheduler().workerCount() * 8 };
+                std::vector<searchState> states{ searchState{0, 1LL << 0, 0LL} };
+
+                while (!states.empty() && states.size() < targetFrontierSize)
                 {
-                    const long long bitMask{ 1LL << adjacentIntersectIndex };
-                    if ((state.passedLookup & bitMask) > 1)
+                    std::vector<searchState> nextStates{};
+                    for (const auto& state : states)
                     {
-                        // already passed in the past of this state
-                        continue;
+                        expandState(state, nextStates, maxDistanceFound);
                     }
 
-                    stateStack.emplace_back(
-                        adjacentIntersectIndex,
-                        state.passedLookup | bitMask,
-                        state.distance + distance
-                    );
+                    states = nextStates;
+                }
+
+                for (const auto& state : states)
+                {
+                    frontier.push_back(FrontierEntry{ state, false, 0 });
                 }
+
+                frontierCheckpoint.save(maxDistanceFound, frontier);
             }
 
-            return maxDistanceFound;
+            std::mutex checkpointMutex{};
+            const long long longestPath{ scheduler::parallel_reduce(0, frontier.size(), maxDistanceFound,
+                [&](const size_t i)
+                {
+                    if (frontier[i].searched)
+                    {
+                        return frontier[i].longestPath;
+                    }
+
+                    const long long longestPathFromState{ findLongestPathFrom(frontier[i].state) };
+
+                    // Saving syncs the file to disk, so only do so once the checkpoint interval has passed.
+                    std::lock_guard lock{ checkpointMutex };
+                    frontier[i] = FrontierEntry{ frontier[i].state, true, longestPathFromState };
+                    if (frontierCheckpoint.due())
+                    {
+                        frontierCheckpoint.save(maxDistanceFound, frontier);
+                    }
+
+                    return longestPathFromState;
+                },
+                [](const long long a, const long long b) { return std::max(a, b); }) };
+
+            frontierCheckpoint.remove();
+            return longestPath;
         }
 
         // long long findLongestPathLengthThroughIntersections()
@@ -600,14 +685,14 @@ namespace day23
         // }
     };
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         Map map{};
         map.parseInput(file);
         return map.findLongestRoute();
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         PartTwoMap map{};
         map.parseInput(file);
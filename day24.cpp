@@ -1,4 +1,6 @@
 #include "day24.h"
+#include "cancellation.h"
+#include "checkpoint.h"
 #include "helpers.h"
 
 #include <algorithm>
@@ -13,9 +15,6 @@
 
 namespace day24
 {
-    long long solvePart1(std::ifstream& file, bool example);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 24 " << (example ? "(example)" : "") << '\n';
@@ -242,11 +241,28 @@ namespace day24
         return true;
     }
 
+    // Rock velocity on two axes for which all hailstones pass through a single point on those axes.
+    struct VelocityCandidate
+    {
+        double velocityA{};
+        double velocityB{};
+        Point intersectPoint{};
+    };
+
+    // Progress of the velocity scans: which scan (0 for x & y, 1 for x & z) is running & at which vx to continue.
+    // The checkpoint records are the x & y candidates found followed by the x & z ones.
+    struct ScanProgress
+    {
+        int scan{};
+        int nextVx{ -500 };
+        size_t nrOfXYCandidates{};
+    };
+
     struct Storm
     {
         std::vector<Hailstone> stones{};
 
-        void parseInput(std::ifstream& file)
+        void parseInput(std::istream& file)
         {
             while (!file.eof())
             {
@@ -317,11 +333,36 @@ namespace day24
             // from the intersection checks.
 
             // Note below code could be refactored a fair bit since logic on x+y & x+z is identical apart from the coordinate used.
-            std::vector<std::pair<std::pair<double, double>, Point>> possibleXYVelocity{};
-            for (int vx = -500; vx < 500; vx++)
+            //
+            // Progress is checkpointed between vx values (at most once a second) so an interrupted scan can resume where it left off.
+            checkpoint::Checkpoint<ScanProgress, VelocityCandidate> scanCheckpoint{ "day24",
+                checkpoint::fingerprint({ reinterpret_cast<const char*>(stones.data()), stones.size() * sizeof(Hailstone) }) };
+
+            ScanProgress progress{};
+            std::vector<VelocityCandidate> candidates{};
+            scanCheckpoint.load(progress, candidates);
+
+            std::vector<VelocityCandidate> possibleXYVelocity(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(progress.nrOfXYCandidates));
+            std::vector<VelocityCandidate> possibleXZVelocity(candidates.begin() + static_cast<std::ptrdiff_t>(progress.nrOfXYCandidates), candidates.end());
+
+            const auto saveProgress{ [&](const int scan, const int nextVx)
             {
+                candidates = possibleXYVelocity;
+                candidates.insert(candidates.end(), possibleXZVelocity.begin(), possibleXZVelocity.end());
+                scanCheckpoint.save(ScanProgress{ scan, nextVx, possibleXYVelocity.size() }, candidates);
+            } };
+
+            for (int vx = progress.scan == 0 ? progress.nextVx : 500; vx < 500; vx++)
+            {
+                if (scanCheckpoint.due())
+                {
+                    saveProgress(0, vx);
+                }
+
                 for (int vy = -500; vy < 500; vy++)
                 {
+                    cancellation::checkpoint();
+
                     if (vy == 0 || vx == 0)
                     {
                         continue;
@@ -386,17 +427,22 @@ namespace day24
 
                     if (!failed)
                     {
-                        possibleXYVelocity.emplace_back(std::pair{ vx, vy }, intersectPoint);
+                        possibleXYVelocity.push_back(VelocityCandidate{ static_cast<double>(vx), static_cast<double>(vy), intersectPoint });
                     }
                 }
             }
 
-            std::vector<std::pair<std::pair<double, double>, Point>> possibleXZVelocity{};
-
-            for (int vx = -500; vx < 500; vx++)
+            for (int vx = progress.scan == 1 ? progress.nextVx : -500; vx < 500; vx++)
             {
+                if (scanCheckpoint.due())
+                {
+                    saveProgress(1, vx);
+                }
+
                 for (int vz = -500; vz < 500; vz++)
                 {
+                    cancellation::checkpoint();
+
                     if (vz == 0 || vx == 0)
                     {
                         continue;
@@ -461,32 +507,34 @@ namespace day24
 
                     if (!failed)
                     {
-                        possibleXZVelocity.emplace_back(std::pair{ vx, vz }, intersectPoint);
+                        possibleXZVelocity.push_back(VelocityCandidate{ static_cast<double>(vx), static_cast<double>(vz), intersectPoint });
                     }
                 }
             }
 
+            scanCheckpoint.remove();
+
             assert(possibleXYVelocity.size() == 1);
             assert(possibleXZVelocity.size() == 1);
-            assert(!doublesAreSignificantlyDifferent(possibleXYVelocity[0].first.first, possibleXZVelocity[0].first.first));
-            assert(!doublesAreSignificantlyDifferent(possibleXYVelocity[0].second.x, possibleXZVelocity[0].second.x));
+            assert(!doublesAreSignificantlyDifferent(possibleXYVelocity[0].velocityA, possibleXZVelocity[0].velocityA));
+            assert(!doublesAreSignificantlyDifferent(possibleXYVelocity[0].intersectPoint.x, possibleXZVelocity[0].intersectPoint.x));
 
-            Point solutionVelocity{ possibleXYVelocity[0].first.first, possibleXYVelocity[0].first.second, possibleXZVelocity[0].first.first };
-            Point solutionOrigin{ possibleXYVelocity[0].second.x, possibleXYVelocity[0].second.y, possibleXZVelocity[0].second.z };
+            Point solutionVelocity{ possibleXYVelocity[0].velocityA, possibleXYVelocity[0].velocityB, possibleXZVelocity[0].velocityA };
+            Point solutionOrigin{ possibleXYVelocity[0].intersectPoint.x, possibleXYVelocity[0].intersectPoint.y, possibleXZVelocity[0].intersectPoint.z };
 
             double sumOfCoordinates{ solutionOrigin.x + solutionOrigin.y + solutionOrigin.z };
             return static_cast<long long>(sumOfCoordinates);
         }
     };
 
-    long long solvePart1(std::ifstream& file, bool example)
+    long long solvePart1(std::istream& file, bool example)
     {
         Storm storm{};
         storm.parseInput(file);
         return storm.countInterectionsInArea(example ? 7.0 : 200000000000000.0, example ? 27.0 : 400000000000000.0);
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         Storm storm{};
         storm.parseInput(file);
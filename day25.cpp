@@ -14,9 +14,6 @@
 
 namespace day25
 {
-    long long solvePart1(std::ifstream& file);
-    long long solvePart2(std::ifstream& file);
-
     void run_day(bool example)
     {
         std::cout << "Running day 25 " << (example ? "(example)" : "") << '\n';
@@ -37,7 +34,7 @@ namespace day25
         std::unordered_map<std::string, size_t> indexLookup{};
         std::vector<std::vector<bool>> connectedLookup{};
 
-        void parseInput(std::ifstream& file)
+        void parseInput(std::istream& file)
         {
             size_t indexCounter{};
             std::vector<std::string> lines{};
@@ -244,7 +241,7 @@ namespace day25
         }
     };
 
-    long long solvePart1(std::ifstream& file)
+    long long solvePart1(std::istream& file)
     {
         Puzzle puzzle{};
         puzzle.parseInput(file);
@@ -252,7 +249,7 @@ namespace day25
         return puzzle.scoreSeperatedGroups();
     }
 
-    long long solvePart2(std::ifstream& file)
+    long long solvePart2(std::istream& file)
     {
         return 0;
     }
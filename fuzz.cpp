@@ -0,0 +1,516 @@
+#include "fuzz.h"
+#include "solvers.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fuzz
+{
+    using Rng = std::mt19937_64;
+
+    // Generates a random valid input for a day. size scales the input (number of lines, grid size, ...) so
+    // mismatches can be shrunk by regenerating with the same seed at a smaller size.
+    struct Generator
+    {
+        int day{};
+        std::function<std::string(Rng&, int)> generate{};
+
+        // Whether any subset of the lines is still a valid input, so mismatches can be shrunk further by
+        // removing lines.
+        bool independentLines{};
+    };
+
+    constexpr int maxSize{ 40 };
+
+    std::vector<std::string> splitLines(const std::string& input)
+    {
+        std::vector<std::string> lines{};
+        std::stringstream inputStream{ input };
+        std::string line;
+        while (std::getline(inputStream, line))
+        {
+            lines.push_back(line);
+        }
+
+        return lines;
+    }
+
+    std::string joinLines(const std::vector<std::string>& lines)
+    {
+        std::string input{};
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            input += (i > 0 ? "\n" : "") + lines[i];
+        }
+
+        return input;
+    }
+
+    int between(Rng& rng, const int low, const int high)
+    {
+        return std::uniform_int_distribution{ low, high }(rng);
+    }
+
+    const std::array<std::string_view, 9> digitWords{ "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
+
+    // Lines of letters mixing in digits & (overlapping) digit words, each with at least one digit.
+    std::string generateDay01(Rng& rng, const int size)
+    {
+        constexpr std::string_view letters{ "abceghinorstuvwxz" };
+        std::string input{};
+        for (int line = 0; line < size; line++)
+        {
+            if (line > 0)
+            {
+                input += '\n';
+            }
+
+            const int pieces{ between(rng, 1, 8) };
+            const int digitPiece{ between(rng, 0, pieces - 1) };
+            for (int piece = 0; piece < pieces; piece++)
+            {
+                switch (between(rng, 0, 2))
+                {
+                case 0:
+                    for (int i = between(rng, 1, 4); i > 0; i--)
+                    {
+                        input += letters[static_cast<size_t>(between(rng, 0, static_cast<int>(letters.size()) - 1))];
+                    }
+                    break;
+                case 1:
+                    input += digitWords[static_cast<size_t>(between(rng, 0, 8))];
+                    break;
+                default:
+                    input += static_cast<char>('1' + between(rng, 0, 8));
+                    break;
+                }
+
+                if (piece == digitPiece)
+                {
+                    input += static_cast<char>('1' + between(rng, 0, 8));
+                }
+            }
+        }
+
+        return input;
+    }
+
+    // Games with up to 6 reveals of 1-3 different colors each.
+    std::string generateDay02(Rng& rng, const int size)
+    {
+        constexpr std::array<std::string_view, 3> colors{ "red", "green", "blue" };
+        std::string input{};
+        for (int game = 1; game <= size; game++)
+        {
+            input += (game > 1 ? "\nGame " : "Game ") + std::to_string(game) + ":";
+            const int reveals{ between(rng, 1, 6) };
+            for (int reveal = 0; reveal < reveals; reveal++)
+            {
+                std::array<size_t, 3> colorOrder{ 0, 1, 2 };
+                std::ranges::shuffle(colorOrder, rng);
+                const int nrOfColors{ between(rng, 1, 3) };
+                for (int color = 0; color < nrOfColors; color++)
+                {
+                    input += (color > 0 ? ", " : " ") + std::to_string(between(rng, 1, 20)) + " " + std::string{ colors[colorOrder[static_cast<size_t>(color)]] };
+                }
+
+                if (reveal + 1 < reveals)
+                {
+                    input += ';';
+                }
+            }
+        }
+
+        return input;
+    }
+
+    // Number of distinct numbers adjacent to the given position of the grid.
+    int countAdjacentNumbers(const std::vector<std::string>& grid, const size_t x, const size_t y)
+    {
+        const size_t firstX{ x > 0 ? x - 1 : 0 };
+        int count{};
+        for (size_t adjacentY = (y > 0 ? y - 1 : 0); adjacentY <= y + 1 && adjacentY < grid.size(); adjacentY++)
+        {
+            for (size_t adjacentX = firstX; adjacentX <= x + 1 && adjacentX < grid[adjacentY].size(); adjacentX++)
+            {
+                // Count each number once, by the leftmost of its digits in range.
+                if (std::isdigit(grid[adjacentY][adjacentX]) && (adjacentX == firstX || !std::isdigit(grid[adjacentY][adjacentX - 1])))
+                {
+                    count++;
+                }
+            }
+        }
+
+        return count;
+    }
+
+    // Square grid of numbers & symbols, both also on the edges of the grid. About half of the '*' with more
+    // than two adjacent numbers are kept, as those are not gears.
+    std::string generateDay03(Rng& rng, const int size)
+    {
+        constexpr std::string_view symbols{ "*#+$/=%@&-" };
+        const int width{ size + 2 };
+        std::vector<std::string> grid(static_cast<size_t>(width));
+        for (int y = 0; y < width; y++)
+        {
+            std::string& row{ grid[static_cast<size_t>(y)] };
+            bool afterNumber{};
+            for (int x = 0; x < width;)
+            {
+                const int choice{ between(rng, 0, 9) };
+                if (!afterNumber && choice < 3)
+                {
+                    const int length{ std::min(between(rng, 1, 3), width - x) };
+                    row += std::to_string(between(rng, 1, 9));
+                    for (int i = 1; i < length; i++)
+                    {
+                        row += static_cast<char>('0' + between(rng, 0, 9));
+                    }
+
+                    x += length;
+                    afterNumber = true;
+                    continue;
+                }
+
+                row += choice < 5 ? symbols[static_cast<size_t>(between(rng, 0, static_cast<int>(symbols.size()) - 1))] : '.';
+                afterNumber = false;
+                x++;
+            }
+        }
+
+        for (size_t y = 0; y < grid.size(); y++)
+        {
+            for (size_t x = 0; x < grid[y].size(); x++)
+            {
+                if (grid[y][x] == '*' && countAdjacentNumbers(grid, x, y) > 2 && between(rng, 0, 1) == 0)
+                {
+                    grid[y][x] = '#';
+                }
+            }
+        }
+
+        return joinLines(grid);
+    }
+
+    // Scratchcards with a fixed number of winning & owned numbers, with the largest sizes making piles of more
+    // than 128 cards. Matches may win copies past the last card, but drop to 0 for a card whose copies would
+    // push a card it wins past a million copies, so the total of part 2 fits an int.
+    std::string generateDay04(Rng& rng, const int size)
+    {
+        constexpr long long maxCopies{ 1000000 };
+        const int nrOfCards{ size <= 30 ? std::min(size, 25) : between(rng, 129, 999) };
+        const int nrOfWinning{ between(rng, 1, 10) };
+        const int nrOfOwned{ between(rng, 1, 25) };
+
+        std::vector<long long> copies(static_cast<size_t>(nrOfCards), 1);
+        std::string input{};
+        for (int card = 1; card <= nrOfCards; card++)
+        {
+            std::vector<int> numbers(99);
+            std::iota(numbers.begin(), numbers.end(), 1);
+            std::ranges::shuffle(numbers, rng);
+
+            int matches{ between(rng, 0, std::min({ nrOfWinning, nrOfOwned, 4 })) };
+            const size_t index{ static_cast<size_t>(card - 1) };
+            for (size_t won = index + 1; won <= index + static_cast<size_t>(matches) && won < copies.size(); won++)
+            {
+                if (copies[won] + copies[index] > maxCopies)
+                {
+                    matches = 0;
+                    break;
+                }
+            }
+
+            for (size_t won = index + 1; won <= index + static_cast<size_t>(matches) && won < copies.size(); won++)
+            {
+                copies[won] += copies[index];
+            }
+
+            std::vector<int> owned(numbers.begin(), numbers.begin() + matches);
+            owned.insert(owned.end(), numbers.begin() + nrOfWinning, numbers.begin() + nrOfWinning + nrOfOwned - matches);
+            std::ranges::shuffle(owned, rng);
+
+            char header[24];
+            std::snprintf(header, sizeof(header), "Card %3d:", card);
+            input += (card > 1 ? "\n" : "") + std::string{ header };
+            for (int i = 0; i < nrOfWinning; i++)
+            {
+                input += (numbers[static_cast<size_t>(i)] < 10 ? "  " : " ") + std::to_string(numbers[static_cast<size_t>(i)]);
+            }
+
+            input += " |";
+            for (const int number : owned)
+            {
+                input += (number < 10 ? "  " : " ") + std::to_string(number);
+            }
+        }
+
+        return input;
+    }
+
+    // Seed ranges followed by the seven mappings, each made of ranges with non-overlapping sources, sometimes
+    // with an extra range overlapping them, where the range listed first wins.
+    std::string generateDay05(Rng& rng, const int size)
+    {
+        constexpr std::array<std::string_view, 7> mappingNames{ "seed-to-soil", "soil-to-fertilizer", "fertilizer-to-water",
+            "water-to-light", "light-to-temperature", "temperature-to-humidity", "humidity-to-location" };
+        const int valueRange{ 100 * size };
+
+        std::vector<std::vector<std::array<int, 3>>> mappings{};
+        for (size_t mapping = 0; mapping < mappingNames.size(); mapping++)
+        {
+            std::vector<int> bounds(static_cast<size_t>(2 * between(rng, 1, std::max(1, size / 2))));
+            std::ranges::generate(bounds, [&] { return between(rng, 0, valueRange); });
+            std::ranges::sort(bounds);
+            const auto duplicates{ std::ranges::unique(bounds) };
+            bounds.erase(duplicates.begin(), duplicates.end());
+
+            std::vector<std::array<int, 3>> ranges{};
+            for (size_t i = 0; i + 1 < bounds.size(); i += 2)
+            {
+                ranges.push_back({ between(rng, 0, valueRange), bounds[i], bounds[i + 1] - bounds[i] });
+            }
+
+            if (ranges.empty())
+            {
+                ranges.push_back({ between(rng, 0, valueRange), bounds[0], 1 });
+            }
+
+            if (between(rng, 0, 2) == 0)
+            {
+                const int start{ between(rng, 0, valueRange) };
+                ranges.push_back({ between(rng, 0, valueRange), start, between(rng, 1, valueRange / 4 + 1) });
+            }
+
+            std::ranges::shuffle(ranges, rng);
+            mappings.push_back(ranges);
+        }
+
+        // Some seeds start right on a source range bound of the first mapping, to hit off by ones there.
+        const auto seedStart{ [&]
+        {
+            const auto& ranges{ mappings.front() };
+            const auto& [target, source, length] = ranges[static_cast<size_t>(between(rng, 0, static_cast<int>(ranges.size()) - 1))];
+            return between(rng, 0, 2) == 0 ? source + between(rng, 0, 1) * length : between(rng, 0, valueRange);
+        } };
+
+        std::string input{ "seeds:" };
+        for (int i = between(rng, 1, 5); i > 0; i--)
+        {
+            input += " " + std::to_string(seedStart()) + " " + std::to_string(between(rng, 1, valueRange / 4 + 1));
+        }
+
+        for (size_t mapping = 0; mapping < mappingNames.size(); mapping++)
+        {
+            input += "\n\n" + std::string{ mappingNames[mapping] } + " map:";
+            for (const auto& [target, source, length] : mappings[mapping])
+            {
+                input += "\n" + std::to_string(target) + " " + std::to_string(source) + " " + std::to_string(length);
+            }
+        }
+
+        return input;
+    }
+
+    // Ghost cycles of small lengths, where reaching the end node takes as long as each loop after it, the
+    // first ghost going from AAA to ZZZ.
+    std::string generateDay08(Rng& rng, const int size)
+    {
+        std::string input{};
+        for (int i = between(rng, 1, 8); i > 0; i--)
+        {
+            input += between(rng, 0, 1) ? 'L' : 'R';
+        }
+
+        input += '\n';
+        const int nrOfGhosts{ between(rng, 1, std::min(size, 6)) };
+        for (int ghost = 0; ghost < nrOfGhosts; ghost++)
+        {
+            const char name{ static_cast<char>('A' + ghost) };
+            std::vector<std::string> nodes(static_cast<size_t>(between(rng, 2, 12)));
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                nodes[i] = name + std::string(i < 10 ? "0" : "") + std::to_string(i);
+            }
+
+            nodes.front() = ghost == 0 ? "AAA" : std::string{ name } + "XA";
+            nodes.back() = ghost == 0 ? "ZZZ" : std::string{ name } + "XZ";
+
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                const std::string& next{ nodes[i + 1 < nodes.size() ? i + 1 : 1] };
+                input += "\n" + nodes[i] + " = (" + next + ", " + next + ")";
+            }
+        }
+
+        return input;
+    }
+
+    const std::vector<Generator> generators{
+        { 1, generateDay01, true },
+        { 2, generateDay02, false },
+        { 3, generateDay03, false },
+        { 4, generateDay04, false },
+        { 5, generateDay05, false },
+        { 8, generateDay08, false }
+    };
+
+    // Answer of an engine as text, so exceptions can be compared as well. Empty if it timed out.
+    std::string engineOutcome(const int day, const solvers::Engine& engine, const std::string& input)
+    {
+        std::istringstream inputStream{ input };
+        try
+        {
+            const solvers::SolveResult result{ solvers::runEngine(day, engine.solve, inputStream) };
+            return result.timedOut ? std::string{} : std::to_string(result.answer);
+        }
+        catch (const std::exception& e)
+        {
+            return std::string{ "exception: " } + e.what();
+        }
+    }
+
+    // Runs all engines of the part on the input, describing the first one to disagree with the reference engine.
+    std::optional<std::string> findMismatch(const int day, const int part, const std::string& input)
+    {
+        const auto& engines{ solvers::getEngines(day, part) };
+        const std::string reference{ engineOutcome(day, engines.front(), input) };
+        if (reference.empty())
+        {
+            return std::nullopt;
+        }
+
+        for (size_t i = 1; i < engines.size(); i++)
+        {
+            const std::string outcome{ engineOutcome(day, engines[i], input) };
+            if (!outcome.empty() && outcome != reference)
+            {
+                return "engine " + engines[i].name + " answered " + outcome + ", reference answered " + reference;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // Size of the input of a case, drawn from its own stream so the input stream doesn't depend on it.
+    int caseSize(const std::uint64_t caseSeed)
+    {
+        Rng sizeRng{ caseSeed };
+        return between(sizeRng, 1, maxSize);
+    }
+
+    // Input of a case at the given size, the same for a seed & size whether the size was drawn or picked while
+    // shrinking.
+    std::string caseInput(const Generator& generator, const std::uint64_t caseSeed, const int size)
+    {
+        constexpr std::uint64_t inputStreamKey{ 0x9e3779b97f4a7c15ull };
+        Rng inputRng{ caseSeed ^ inputStreamKey };
+        return generator.generate(inputRng, size);
+    }
+
+    // Shrinks a failing input, first to the smallest size failing for the same seed, then by removing
+    // ever smaller chunks of lines while the mismatch remains.
+    std::string shrink(const Generator& generator, const int part, const std::uint64_t caseSeed, const int size, std::string input)
+    {
+        for (int smallerSize = 1; smallerSize < size; smallerSize++)
+        {
+            std::string smallerInput{ caseInput(generator, caseSeed, smallerSize) };
+            if (findMismatch(generator.day, part, smallerInput))
+            {
+                input = smallerInput;
+                break;
+            }
+        }
+
+        if (!generator.independentLines)
+        {
+            return input;
+        }
+
+        std::vector<std::string> lines{ splitLines(input) };
+        for (size_t chunkSize = lines.size() / 2; chunkSize > 0; chunkSize /= 2)
+        {
+            for (size_t start = 0; start < lines.size() && lines.size() > 1;)
+            {
+                std::vector<std::string> remaining{ lines };
+                remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(start),
+                    remaining.begin() + static_cast<std::ptrdiff_t>(std::min(start + chunkSize, remaining.size())));
+
+                if (!remaining.empty() && findMismatch(generator.day, part, joinLines(remaining)))
+                {
+                    lines = remaining;
+                    continue;
+                }
+
+                start += chunkSize;
+            }
+        }
+
+        return joinLines(lines);
+    }
+
+    // Runs every engine of each day with an input generator against the reference engine on seeded random
+    // inputs, for all days or only the given one. Mismatches are shrunk, printed & saved to
+    // fuzz_dayNN_partP_<seed>.txt. Returns the number of mismatches, so it can gate a build.
+    int run_fuzz(const std::uint64_t seed, const int iterations, const int onlyDay)
+    {
+        int mismatches{};
+        for (const auto& generator : generators)
+        {
+            if (onlyDay != 0 && generator.day != onlyDay)
+            {
+                continue;
+            }
+
+            for (int part = 1; part <= 2; part++)
+            {
+                if (solvers::getEngines(generator.day, part).size() < 2)
+                {
+                    continue;
+                }
+
+                int partMismatches{};
+                for (int iteration = 0; iteration < iterations; iteration++)
+                {
+                    const std::uint64_t caseSeed{ seed + static_cast<std::uint64_t>(iteration) };
+                    const int size{ caseSize(caseSeed) };
+                    const std::string input{ caseInput(generator, caseSeed, size) };
+
+                    if (!findMismatch(generator.day, part, input))
+                    {
+                        continue;
+                    }
+
+                    const std::string shrunk{ shrink(generator, part, caseSeed, size, input) };
+                    const std::string fileName{ "fuzz_day" + std::string(generator.day < 10 ? "0" : "") + std::to_string(generator.day)
+                        + "_part" + std::to_string(part) + "_" + std::to_string(caseSeed) + ".txt" };
+                    std::ofstream{ fileName } << shrunk;
+
+                    const auto mismatch{ findMismatch(generator.day, part, shrunk) };
+                    std::cout << "Day " << generator.day << " part " << part << " seed " << caseSeed << " size " << size << ": "
+                        << mismatch.value_or("mismatch") << ", shrunk input saved to " << fileName << ":\n" << shrunk << '\n';
+                    partMismatches++;
+                }
+
+                std::cout << "Day " << generator.day << " part " << part << ": " << iterations << " inputs, "
+                    << partMismatches << " mismatches\n";
+                mismatches += partMismatches;
+            }
+        }
+
+        return mismatches;
+    }
+}
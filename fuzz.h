@@ -0,0 +1,7 @@
+#pragma once
+#include <cstdint>
+
+namespace fuzz
+{
+    int run_fuzz(std::uint64_t seed, int iterations, int onlyDay);
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Grid position packed into a single 32-bit linear index (y * rowStride + x), for grids of up to 65535 by 65535.
+// Because the row stride is a fixed power of two, the offset for a step in each direction is a compile time
+// constant, and stepping off the low edge of the grid wraps x or y around to 65535. That fails the usual
+// x < width check, just like the size_t overflow trick used for unpacked coordinates.
+struct GridPos
+{
+    static constexpr std::uint32_t rowStride{ 1u << 16 };
+
+    // Offsets to add to a position for a single step in each direction.
+    static constexpr std::int32_t north{ -static_cast<std::int32_t>(rowStride) };
+    static constexpr std::int32_t east{ 1 };
+    static constexpr std::int32_t south{ static_cast<std::int32_t>(rowStride) };
+    static constexpr std::int32_t west{ -1 };
+    static constexpr std::array<std::int32_t, 4> directionOffsets{ north, east, south, west };
+
+    std::uint32_t index{};
+
+    constexpr GridPos() = default;
+
+    constexpr GridPos(const size_t x, const size_t y) : index{ static_cast<std::uint32_t>(y * rowStride + x) } {}
+
+    [[nodiscard]] constexpr size_t x() const { return index & (rowStride - 1); }
+
+    [[nodiscard]] constexpr size_t y() const { return index >> 16; }
+
+    [[nodiscard]] constexpr bool inBounds(const size_t width, const size_t height) const
+    {
+        return x() < width && y() < height;
+    }
+
+    [[nodiscard]] constexpr GridPos operator+(const std::int32_t offset) const
+    {
+        GridPos result{};
+        result.index = index + static_cast<std::uint32_t>(offset);
+        return result;
+    }
+
+    // Position one step in the given direction, for any direction enum ordered north, east, south, west.
+    template <typename Direction>
+    [[nodiscard]] constexpr GridPos step(const Direction direction) const
+    {
+        return *this + directionOffsets[static_cast<size_t>(direction)];
+    }
+
+    [[nodiscard]] constexpr bool operator==(const GridPos& other) const = default;
+};
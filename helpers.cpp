@@ -1,3 +1,4 @@
+#include <istream>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -82,4 +83,25 @@ std::vector<std::string> splitStringBySeperator(std::string_view string, char se
     result.emplace_back(string);
 
     return result;
-}
\ No newline at end of file
+}
+
+// Reads the rest of the stream into a string, in one go if the stream can tell its size.
+std::string readAll(std::istream& file)
+{
+    const auto start{ file.tellg() };
+    if (start >= 0 && file.seekg(0, std::ios::end))
+    {
+        const auto end{ file.tellg() };
+        file.seekg(start);
+
+        std::string contents(static_cast<size_t>(end - start), '\0');
+        file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+        contents.resize(static_cast<size_t>(file.gcount()));
+        return contents;
+    }
+
+    file.clear();
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -6,3 +7,4 @@ std::vector<int> parseLineOfNumbers(const std::string_view line);
 std::vector<long long> parseLineOfNumbersToLongLong(const std::string_view line);
 std::vector<int> parseLineOfSymbolSeperatedNumbers(const std::string_view line);
 std::vector<std::string> splitStringBySeperator(std::string_view string, char seperator);
+std::string readAll(std::istream& file);
@@ -0,0 +1,429 @@
+#include "loader.h"
+#include "scheduler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define HAS_IO_URING
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace loader
+{
+    // Blocking read of a full file, using pread where available.
+    LoadedFile readFile(const size_t index, const std::string& fileName)
+    {
+        LoadedFile loaded{ index };
+#ifdef _WIN32
+        std::ifstream file{ fileName, std::ios::binary };
+        if (!file)
+        {
+            return loaded;
+        }
+
+        loaded.contents.assign(std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{});
+        loaded.ok = true;
+#else
+        const int fd{ open(fileName.c_str(), O_RDONLY | O_CLOEXEC) };
+        struct stat fileStat{};
+        if (fd < 0 || fstat(fd, &fileStat) != 0)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+
+            return loaded;
+        }
+
+        loaded.contents.resize(static_cast<size_t>(fileStat.st_size));
+        size_t offset{};
+        while (offset < loaded.contents.size())
+        {
+            const auto result{ pread(fd, loaded.contents.data() + offset, loaded.contents.size() - offset, static_cast<off_t>(offset)) };
+            if (result <= 0)
+            {
+                break;
+            }
+
+            offset += static_cast<size_t>(result);
+        }
+
+        close(fd);
+        loaded.contents.resize(offset);
+        loaded.ok = offset == static_cast<size_t>(fileStat.st_size);
+#endif
+        return loaded;
+    }
+
+    // Fallback: every file is read by a blocking task on the scheduler.
+    void loadFilesOnScheduler(const std::vector<std::string>& fileNames, const OnLoaded& onLoaded)
+    {
+        scheduler::TaskGroup group{};
+        for (size_t i = 0; i < fileNames.size(); i++)
+        {
+            group.fork([&fileNames, &onLoaded, i] { onLoaded(readFile(i, fileNames[i])); });
+        }
+
+        group.join();
+    }
+
+#ifdef HAS_IO_URING
+    // Minimal io_uring wrapper (without liburing), talking to the kernel through the shared submission
+    // and completion rings directly.
+    class Uring
+    {
+    public:
+        explicit Uring(const unsigned entries)
+        {
+            io_uring_params params{};
+            ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+            if (ringFd < 0)
+            {
+                return;
+            }
+
+            sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            const bool singleMmap{ (params.features & IORING_FEAT_SINGLE_MMAP) != 0 };
+            if (singleMmap)
+            {
+                sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+            }
+
+            sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+            cqRing = singleMmap ? sqRing : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+            void* sqesMemory{ mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES) };
+            if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqesMemory == MAP_FAILED)
+            {
+                close(ringFd);
+                ringFd = -1;
+                return;
+            }
+
+            char* sq{ static_cast<char*>(sqRing) };
+            char* cq{ static_cast<char*>(cqRing) };
+            sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            sqes = static_cast<io_uring_sqe*>(sqesMemory);
+            cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            localSqTail = *sqTail;
+            capacity = params.sq_entries;
+        }
+
+        ~Uring()
+        {
+            if (ringFd < 0)
+            {
+                return;
+            }
+
+            munmap(sqes, sqesSize);
+            if (cqRing != sqRing)
+            {
+                munmap(cqRing, cqRingSize);
+            }
+
+            munmap(sqRing, sqRingSize);
+            close(ringFd);
+        }
+
+        Uring(const Uring&) = delete;
+        Uring& operator=(const Uring&) = delete;
+
+        [[nodiscard]] bool valid() const { return ringFd >= 0; }
+
+        [[nodiscard]] unsigned entries() const { return capacity; }
+
+        // Claims the next submission queue entry, callers must keep the nr of queued & in flight requests
+        // within entries().
+        io_uring_sqe* nextSqe()
+        {
+            const unsigned index{ localSqTail & sqMask };
+            io_uring_sqe* sqe{ &sqes[index] };
+            std::memset(sqe, 0, sizeof(io_uring_sqe));
+            sqArray[index] = index;
+            localSqTail++;
+            toSubmit++;
+            return sqe;
+        }
+
+        // Submits all queued entries and waits until at least one completion is available.
+        bool submitAndWait()
+        {
+            std::atomic_ref{ *sqTail }.store(localSqTail, std::memory_order_release);
+            while (true)
+            {
+                const auto result{ syscall(__NR_io_uring_enter, ringFd, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0) };
+                if (result >= 0)
+                {
+                    toSubmit -= static_cast<unsigned>(result);
+                    return true;
+                }
+
+                if (errno != EINTR)
+                {
+                    return false;
+                }
+            }
+        }
+
+        // Waits for at least one more completion without submitting anything.
+        bool waitForCompletion()
+        {
+            while (true)
+            {
+                if (syscall(__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) >= 0)
+                {
+                    return true;
+                }
+
+                if (errno != EINTR)
+                {
+                    return false;
+                }
+            }
+        }
+
+        // Entries queued since the last successful submit, which the kernel hasn't seen.
+        [[nodiscard]] unsigned unsubmitted() const { return toSubmit; }
+
+        template <typename Handler>
+        void forEachCompletion(const Handler& handler)
+        {
+            unsigned head{ std::atomic_ref{ *cqHead }.load(std::memory_order_relaxed) };
+            const unsigned tail{ std::atomic_ref{ *cqTail }.load(std::memory_order_acquire) };
+            while (head != tail)
+            {
+                const io_uring_cqe& cqe{ cqes[head & cqMask] };
+                handler(cqe.user_data, cqe.res);
+                head++;
+            }
+
+            std::atomic_ref{ *cqHead }.store(head, std::memory_order_release);
+        }
+
+    private:
+        int ringFd{ -1 };
+        unsigned capacity{};
+        size_t sqRingSize{};
+        size_t cqRingSize{};
+        size_t sqesSize{};
+        void* sqRing{};
+        void* cqRing{};
+        unsigned* sqTail{};
+        unsigned sqMask{};
+        unsigned* sqArray{};
+        io_uring_sqe* sqes{};
+        unsigned* cqHead{};
+        unsigned* cqTail{};
+        unsigned cqMask{};
+        io_uring_cqe* cqes{};
+        unsigned localSqTail{};
+        unsigned toSubmit{};
+    };
+
+    // Keeps up to the ring's capacity of opens & reads in flight. Opened files are sized with fstat and read
+    // in as few reads as possible; each file is handed to onLoaded on this thread as soon as it's complete.
+    bool loadFilesWithUring(const std::vector<std::string>& fileNames, const OnLoaded& onLoaded)
+    {
+        struct FileState
+        {
+            int fd{ -1 };
+            std::string contents{};
+            size_t bytesRead{};
+            bool done{};
+        };
+
+        // Read requests write straight into these buffers, so they may only be released once no request is in
+        // flight anymore. Tearing down the ring doesn't wait for that.
+        std::vector<FileState> files(fileNames.size());
+
+        Uring ring{ 64 };
+        if (!ring.valid())
+        {
+            return false;
+        }
+
+        // user_data is the file index shifted up by one, with the lowest bit marking read (vs open) requests.
+        size_t nextToOpen{};
+        size_t finished{};
+        unsigned inFlight{};
+
+        auto queueRead = [&](const size_t index)
+        {
+            FileState& file{ files[index] };
+            io_uring_sqe* sqe{ ring.nextSqe() };
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = file.fd;
+            sqe->addr = reinterpret_cast<std::uint64_t>(file.contents.data() + file.bytesRead);
+            sqe->len = static_cast<std::uint32_t>(std::min<size_t>(file.contents.size() - file.bytesRead, 1u << 30));
+            sqe->off = file.bytesRead;
+            sqe->user_data = (index << 1) | 1;
+            inFlight++;
+        };
+
+        auto finish = [&](const size_t index, const bool ok)
+        {
+            FileState& file{ files[index] };
+            if (file.fd >= 0)
+            {
+                close(file.fd);
+            }
+
+            file.contents.resize(file.bytesRead);
+            onLoaded(LoadedFile{ index, std::move(file.contents), ok });
+            file = FileState{};
+            file.done = true;
+            finished++;
+        };
+
+        while (finished < fileNames.size())
+        {
+            while (nextToOpen < fileNames.size() && inFlight < ring.entries())
+            {
+                io_uring_sqe* sqe{ ring.nextSqe() };
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->fd = AT_FDCWD;
+                sqe->addr = reinterpret_cast<std::uint64_t>(fileNames[nextToOpen].c_str());
+                sqe->open_flags = O_RDONLY | O_CLOEXEC;
+                sqe->user_data = nextToOpen << 1;
+                nextToOpen++;
+                inFlight++;
+            }
+
+            if (!ring.submitAndWait())
+            {
+                // Ring broke down. Wait for the requests the kernel already took to complete before the buffers
+                // can be released, closing the files their opens still returned.
+                unsigned submitted{ inFlight - ring.unsubmitted() };
+                while (submitted > 0 && ring.waitForCompletion())
+                {
+                    ring.forEachCompletion([&](const std::uint64_t userData, const int result)
+                    {
+                        submitted--;
+                        if ((userData & 1) == 0 && result >= 0)
+                        {
+                            close(result);
+                        }
+                    });
+                }
+
+                // Read whatever is left the blocking way.
+                for (size_t i = 0; i < files.size(); i++)
+                {
+                    if (!files[i].done)
+                    {
+                        if (files[i].fd >= 0)
+                        {
+                            close(files[i].fd);
+                        }
+
+                        onLoaded(readFile(i, fileNames[i]));
+                    }
+                }
+
+                if (submitted > 0)
+                {
+                    // No telling when the kernel is done with the buffers, so they are never released. Moving
+                    // the vector keeps its elements (& their strings) where they are.
+                    static_cast<void>(new std::vector<FileState>(std::move(files)));
+                }
+
+                return true;
+            }
+
+            ring.forEachCompletion([&](const std::uint64_t userData, const int result)
+            {
+                inFlight--;
+                const size_t index{ static_cast<size_t>(userData >> 1) };
+                FileState& file{ files[index] };
+
+                if ((userData & 1) == 0)
+                {
+                    if (result == -EINVAL)
+                    {
+                        // Kernel too old for opening through io_uring, read this one the blocking way.
+                        onLoaded(readFile(index, fileNames[index]));
+                        file.done = true;
+                        finished++;
+                        return;
+                    }
+
+                    struct stat fileStat{};
+                    file.fd = result;
+                    if (result < 0 || fstat(file.fd, &fileStat) != 0)
+                    {
+                        finish(index, false);
+                        return;
+                    }
+
+                    file.contents.resize(static_cast<size_t>(fileStat.st_size));
+                    if (file.contents.empty())
+                    {
+                        finish(index, true);
+                        return;
+                    }
+
+                    queueRead(index);
+                    return;
+                }
+
+                if (result <= 0)
+                {
+                    // Error, or the file shrunk since we sized it.
+                    finish(index, result == 0);
+                    return;
+                }
+
+                file.bytesRead += static_cast<size_t>(result);
+                if (file.bytesRead == file.contents.size())
+                {
+                    finish(index, true);
+                    return;
+                }
+
+                queueRead(index);
+            });
+        }
+
+        return true;
+    }
+#endif
+
+    // Reads all given files, calling onLoaded for each one as soon as it has been read completely, so not
+    // necessarily in order and possibly from several threads at once. Uses io_uring to keep many opens and
+    // reads in flight at the same time when available, else falls back to blocking reads on the scheduler.
+    void loadFiles(const std::vector<std::string>& fileNames, const OnLoaded& onLoaded)
+    {
+#ifdef HAS_IO_URING
+        if (loadFilesWithUring(fileNames, onLoaded))
+        {
+            return;
+        }
+#endif
+
+        loadFilesOnScheduler(fileNames, onLoaded);
+    }
+}
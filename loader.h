@@ -0,0 +1,18 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace loader
+{
+    struct LoadedFile
+    {
+        size_t index{};
+        std::string contents{};
+        bool ok{};
+    };
+
+    using OnLoaded = std::function<void(LoadedFile)>;
+
+    void loadFiles(const std::vector<std::string>& fileNames, const OnLoaded& onLoaded);
+}
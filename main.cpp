@@ -1,3 +1,6 @@
+#include "autotune.h"
+#include "batch.h"
+#include "checkpoint.h"
 #include "day01.h"
 #include "day02.h"
 #include "day03.h"
@@ -23,9 +26,199 @@
 #include "day23.h"
 #include "day24.h"
 #include "day25.h"
+#include "fuzz.h"
+#include "profiler.h"
+#include "server.h"
+#include "solvers.h"
 
-int main()
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Runs the real input of the given days through the solver registry with the profiler tagging each part.
+void runProfiled(const std::string& outputFileName, const int firstDay, const int lastDay)
+{
+    if (!profiler::start(outputFileName))
+    {
+        return;
+    }
+
+    for (int day = firstDay; day <= lastDay; day++)
+    {
+        const std::string fileName{ "inputs/day" + std::string(day < 10 ? "0" : "") + std::to_string(day) + "_real.txt" };
+        for (int part = 1; part <= 2; part++)
+        {
+            std::ifstream file{ fileName };
+            const profiler::DayScope scope{ day, part };
+            const auto result{ solvers::runTimed(day, part, file) };
+            if (result.timedOut)
+            {
+                std::cout << "Day " << day << " part " << part << " timed out after " << result.microseconds << " us ("
+                    << result.iterations << " iterations done)\n";
+                continue;
+            }
+
+            std::cout << "Day " << day << " part " << part << " answer: " << result.answer << " (" << result.microseconds << " us)\n";
+        }
+    }
+
+    profiler::stop();
+}
+
+// Sets the time budgets from a comma separated list of seconds for all days and/or day=seconds pairs,
+// e.g. "10" or "30,23=60,24=120".
+void setTimeBudgets(const std::string& budgets)
 {
+    std::stringstream budgetStream{ budgets };
+    std::string budget;
+    while (std::getline(budgetStream, budget, ','))
+    {
+        const auto sepPos{ budget.find('=') };
+        const std::chrono::milliseconds milliseconds{ static_cast<long long>(std::stod(budget.substr(sepPos + 1)) * 1000) };
+        if (sepPos == std::string::npos)
+        {
+            solvers::setTimeBudget(milliseconds);
+        }
+        else
+        {
+            solvers::setTimeBudget(std::stoi(budget.substr(0, sepPos)), milliseconds);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    // Options applying to all modes below.
+    std::string engineConfigFileName{ "engines.cfg" };
+    while (!args.empty() && args[0].starts_with("--"))
+    {
+        if (args[0] == "--verify")
+        {
+            // Run all engines of a part & check they agree with the reference engine.
+            solvers::setVerify(true);
+            args.erase(args.begin());
+            continue;
+        }
+
+        if (args.size() < 2)
+        {
+            break;
+        }
+
+        if (args[0] == "--time-budget")
+        {
+            // Cancel solvers running past their time budget.
+            setTimeBudgets(args[1]);
+        }
+        else if (args[0] == "--checkpoint-dir")
+        {
+            // Let long searches checkpoint their progress in this directory & resume from it.
+            checkpoint::setDirectory(args[1]);
+        }
+        else if (args[0] == "--engine-config")
+        {
+            // Read (and autotune into) this engine config instead of the default one.
+            engineConfigFileName = args[1];
+        }
+        else
+        {
+            break;
+        }
+
+        args.erase(args.begin(), args.begin() + 2);
+    }
+
+    solvers::loadEngineConfig(engineConfigFileName);
+
+    // Compare all engines against the reference engine on seeded random inputs, failing on any mismatch.
+    if ((args.size() == 3 || args.size() == 4) && args[0] == "--fuzz")
+    {
+        const int day{ args.size() == 4 ? std::stoi(args[3]) : 0 };
+        return fuzz::run_fuzz(std::stoull(args[1]), std::stoi(args[2]), day) == 0 ? 0 : 1;
+    }
+
+    // Time the engines of each day on its sample inputs & save the fastest by input size to the engine config.
+    if (args.size() == 1 && args[0] == "--autotune")
+    {
+        autotune::run_autotune(engineConfigFileName);
+        return 0;
+    }
+
+    // Run as a long-lived daemon answering solve requests over a unix domain socket.
+    if (args.size() == 2 && args[0] == "--daemon")
+    {
+        server::run_server(args[1]);
+        return 0;
+    }
+
+    // Profile all days (or a single one), writing folded stacks to the given file.
+    if ((args.size() == 2 || args.size() == 3) && args[0] == "--profile")
+    {
+        const int day{ args.size() == 3 ? std::stoi(args[2]) : 0 };
+        runProfiled(args[1], day > 0 ? day : 1, day > 0 ? day : 25);
+        return 0;
+    }
+
+    // Sum the IDs of the day 2 games possible with each bag of a queries file.
+    if (args.size() == 3 && args[0] == "--bag-limits")
+    {
+        day02::run_bag_limits(args[1], args[2]);
+        return 0;
+    }
+
+    // Parse a day 2 game log into a columnar store file, or answer both parts from such a file.
+    if (args.size() == 3 && args[0] == "--save-columns")
+    {
+        day02::run_save_columns(args[1], args[2]);
+        return 0;
+    }
+
+    if (args.size() == 2 && args[0] == "--columns")
+    {
+        day02::run_columns(args[1]);
+        return 0;
+    }
+
+    // Update the day 2 answers of a growing game log with the lines appended since the previous run.
+    if (args.size() == 2 && args[0] == "--tail")
+    {
+        day02::run_tail(args[1]);
+        return 0;
+    }
+
+    // Apply single cell edits to a day 3 schematic, updating both answers after each.
+    if (args.size() == 3 && args[0] == "--edit-schematic")
+    {
+        day03::run_schematic_edits(args[1], args[2]);
+        return 0;
+    }
+
+    // Map each seed of a seeds file to its location with the mappings of a day 5 almanac.
+    if (args.size() == 3 && args[0] == "--map-seeds")
+    {
+        day05::run_map_seeds(args[1], args[2]);
+        return 0;
+    }
+
+    // Find the seeds reaching location intervals, or the k-th lowest location reached, for a day 5 almanac.
+    if (args.size() == 3 && args[0] == "--reverse-queries")
+    {
+        day05::run_reverse_queries(args[1], args[2]);
+        return 0;
+    }
+
+    // Solve a single day & part for many input files at once.
+    if (args.size() >= 4 && args[0] == "--batch")
+    {
+        batch::run_batch(std::stoi(args[1]), std::stoi(args[2]), std::vector<std::string>(args.begin() + 3, args.end()));
+        return 0;
+    }
+
     day01::run_day(false);
     day02::run_day(false);
     day03::run_day(false);
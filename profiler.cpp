@@ -0,0 +1,267 @@
+#include "profiler.h"
+
+#include <atomic>
+#include <iostream>
+#include <string>
+
+#if (defined(__unix__) || defined(__APPLE__)) && __has_include(<execinfo.h>)
+#define HAS_SAMPLING_PROFILER
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <sys/time.h>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#endif
+
+namespace profiler
+{
+    // Per thread, as the signal handler runs on the thread it interrupted. Constant initialised, so reading it
+    // from the handler never allocates.
+    constinit thread_local DayTag threadTag{};
+
+    DayTag currentTag()
+    {
+        return threadTag;
+    }
+
+    DayScope::DayScope(const int day, const int part) : DayScope{ DayTag{ day, part } }
+    {
+    }
+
+    DayScope::DayScope(const DayTag tag) : previous{ threadTag }
+    {
+        threadTag = tag;
+    }
+
+    DayScope::~DayScope()
+    {
+        threadTag = previous;
+    }
+
+#ifdef HAS_SAMPLING_PROFILER
+    constexpr int samplesPerSecond{ 1000 };
+    constexpr int maxStackDepth{ 64 };
+    constexpr size_t ringCapacity{ 1 << 14 };
+
+    // Frames of the signal handler & signal trampoline at the top of every captured stack.
+    constexpr int handlerFrames{ 2 };
+
+    struct Sample
+    {
+        std::atomic<bool> ready{};
+        int day{};
+        int part{};
+        int depth{};
+        std::array<void*, maxStackDepth> frames{};
+    };
+
+    // Lock-free ring of samples: the signal handler claims a slot through writeIndex and publishes it by
+    // setting ready, the collector thread folds any ready slot and hands it back by clearing ready.
+    // If the collector falls a full ring behind, new samples are dropped instead of waiting.
+    std::unique_ptr<std::array<Sample, ringCapacity>> ring{};
+    std::atomic<size_t> writeIndex{};
+    std::atomic<size_t> droppedSamples{};
+
+    std::atomic<bool> collecting{};
+    std::thread collector{};
+    std::string outputFile{};
+
+    // Sample counts per unique (day, part, stack).
+    std::map<std::tuple<int, int, std::vector<void*>>, size_t> stackCounts{};
+
+    void onProfilingSignal(int)
+    {
+        const int savedErrno{ errno };
+        Sample& sample{ (*ring)[writeIndex.fetch_add(1, std::memory_order_relaxed) % ringCapacity] };
+        if (sample.ready.load(std::memory_order_acquire))
+        {
+            droppedSamples.fetch_add(1, std::memory_order_relaxed);
+            errno = savedErrno;
+            return;
+        }
+
+        sample.day = threadTag.day;
+        sample.part = threadTag.part;
+        sample.depth = backtrace(sample.frames.data(), maxStackDepth);
+        sample.ready.store(true, std::memory_order_release);
+        errno = savedErrno;
+    }
+
+    void drainRing()
+    {
+        for (Sample& sample : *ring)
+        {
+            if (!sample.ready.load(std::memory_order_acquire))
+            {
+                continue;
+            }
+
+            if (sample.depth > handlerFrames)
+            {
+                std::vector<void*> stack(sample.frames.begin() + handlerFrames, sample.frames.begin() + sample.depth);
+                stackCounts[{ sample.day, sample.part, stack }]++;
+            }
+
+            sample.ready.store(false, std::memory_order_release);
+        }
+    }
+
+    // Turns a backtrace_symbols entry like "binary(function+0x1f) [0x4005d0]" into a demangled function name.
+    // Only exported symbols have names there, so link with -rdynamic to get more than raw addresses.
+    std::string symbolName(const char* symbol, void* address)
+    {
+        const std::string entry{ symbol };
+        const size_t open{ entry.find('(') };
+        const size_t end{ entry.find_first_of("+)", open) };
+        if (open == std::string::npos || end == std::string::npos || end == open + 1)
+        {
+            std::stringstream unknown;
+            unknown << address;
+            return unknown.str();
+        }
+
+        const std::string mangled{ entry.substr(open + 1, end - open - 1) };
+        int status{};
+        char* demangled{ abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status) };
+        std::string name{ status == 0 ? demangled : mangled };
+        std::free(demangled);
+
+        // Folded stacks use ';' as seperator, so it can't appear in frame names.
+        for (char& c : name)
+        {
+            if (c == ';')
+            {
+                c = ':';
+            }
+        }
+
+        return name;
+    }
+
+    // Writes the samples as folded stacks ("root;...;leaf count" per line), rooted at the day & part,
+    // ready for flamegraph.pl or speedscope.
+    void writeFoldedStacks()
+    {
+        std::unordered_map<void*, std::string> names{};
+        for (const auto& [key, count] : stackCounts)
+        {
+            for (void* address : std::get<2>(key))
+            {
+                if (names.contains(address))
+                {
+                    continue;
+                }
+
+                char** symbols{ backtrace_symbols(&address, 1) };
+                names[address] = symbols ? symbolName(symbols[0], address) : "??";
+                std::free(symbols);
+            }
+        }
+
+        std::ofstream file{ outputFile };
+        size_t totalSamples{};
+        for (const auto& [key, count] : stackCounts)
+        {
+            const auto& [day, part, stack] = key;
+            if (day > 0)
+            {
+                file << "day" << (day < 10 ? "0" : "") << day << " part " << part;
+            }
+            else
+            {
+                file << "untagged";
+            }
+
+            for (auto frame = stack.rbegin(); frame != stack.rend(); ++frame)
+            {
+                file << ';' << names[*frame];
+            }
+
+            file << ' ' << count << '\n';
+            totalSamples += count;
+        }
+
+        std::cout << "Profiler wrote " << totalSamples << " samples to " << outputFile
+            << " (" << droppedSamples << " dropped)\n";
+    }
+
+    // Starts sampling the whole process through SIGPROF, folded stacks get written to outputFileName on stop().
+    bool start(const std::string& outputFileName)
+    {
+        if (collecting)
+        {
+            return false;
+        }
+
+        outputFile = outputFileName;
+        ring = std::make_unique<std::array<Sample, ringCapacity>>();
+        stackCounts.clear();
+        droppedSamples = 0;
+
+        // backtrace loads libgcc on its first call, which isn't safe from within a signal handler.
+        void* warmUp[1];
+        backtrace(warmUp, 1);
+
+        struct sigaction action{};
+        action.sa_handler = onProfilingSignal;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGPROF, &action, nullptr);
+
+        collecting = true;
+        collector = std::thread([]
+        {
+            while (collecting)
+            {
+                drainRing();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        });
+
+        itimerval timer{};
+        timer.it_interval.tv_usec = 1000000 / samplesPerSecond;
+        timer.it_value = timer.it_interval;
+        setitimer(ITIMER_PROF, &timer, nullptr);
+        return true;
+    }
+
+    void stop()
+    {
+        if (!collecting)
+        {
+            return;
+        }
+
+        constexpr itimerval disabled{};
+        setitimer(ITIMER_PROF, &disabled, nullptr);
+        signal(SIGPROF, SIG_IGN);
+
+        collecting = false;
+        collector.join();
+        drainRing();
+        writeFoldedStacks();
+        ring.reset();
+    }
+#else
+    bool start(const std::string&)
+    {
+        std::cout << "Sampling profiler isn't supported on this platform\n";
+        return false;
+    }
+
+    void stop()
+    {
+    }
+#endif
+}
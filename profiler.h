@@ -0,0 +1,34 @@
+#pragma once
+#include <string>
+
+namespace profiler
+{
+    bool start(const std::string& outputFileName);
+    void stop();
+
+    // Day & part a thread is solving, 0 when outside any DayScope.
+    struct DayTag
+    {
+        int day{};
+        int part{};
+    };
+
+    // Tag of the calling thread. The scheduler carries it over to forked tasks, so samples taken on workers
+    // are tagged with the solve that forked them, even with several solves running at once.
+    DayTag currentTag();
+
+    // Tags all samples taken on this thread while in scope with the given day & part.
+    class DayScope
+    {
+    public:
+        DayScope(int day, int part);
+        explicit DayScope(DayTag tag);
+        ~DayScope();
+
+        DayScope(const DayScope&) = delete;
+        DayScope& operator=(const DayScope&) = delete;
+
+    private:
+        DayTag previous;
+    };
+}
@@ -0,0 +1,126 @@
+#include "scheduler.h"
+
+namespace scheduler
+{
+    // Index of the worker owned by the current thread, or -1 for threads outside the scheduler.
+    thread_local int currentWorkerIndex{ -1 };
+
+    Scheduler::Scheduler(const size_t workerCount)
+    {
+        for (size_t i = 0; i < std::max<size_t>(workerCount, 1); i++)
+        {
+            workers.push_back(std::make_unique<Worker>());
+        }
+
+        for (size_t i = 0; i < workers.size(); i++)
+        {
+            threads.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    Scheduler::~Scheduler()
+    {
+        {
+            std::lock_guard lock{ sleepMutex };
+            stopping = true;
+        }
+
+        wakeUp.notify_all();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void Scheduler::submit(Task task)
+    {
+        // Workers push onto their own deque, other threads spread their tasks round-robin.
+        const size_t workerIndex{ currentWorkerIndex >= 0
+            ? static_cast<size_t>(currentWorkerIndex)
+            : nextExternalWorker++ % workers.size() };
+
+        {
+            std::lock_guard lock{ workers[workerIndex]->mutex };
+            workers[workerIndex]->tasks.push_back(std::move(task));
+        }
+
+        {
+            std::lock_guard lock{ sleepMutex };
+            ++queuedTasks;
+        }
+
+        wakeUp.notify_one();
+    }
+
+    // Takes a task from the back of the given worker's own deque, or steals one from the front of another's.
+    bool Scheduler::tryPop(const size_t workerIndex, Task& task)
+    {
+        for (size_t offset = 0; offset < workers.size(); offset++)
+        {
+            Worker& worker{ *workers[(workerIndex + offset) % workers.size()] };
+            std::lock_guard lock{ worker.mutex };
+            if (worker.tasks.empty())
+            {
+                continue;
+            }
+
+            if (offset == 0)
+            {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+            }
+
+            --queuedTasks;
+            return true;
+        }
+
+        return false;
+    }
+
+    // Runs a single queued task on the calling thread, if there is any.
+    bool Scheduler::tryRunOne()
+    {
+        Task task;
+        const size_t workerIndex{ currentWorkerIndex >= 0 ? static_cast<size_t>(currentWorkerIndex) : 0 };
+        if (!tryPop(workerIndex, task))
+        {
+            return false;
+        }
+
+        task();
+        return true;
+    }
+
+    void Scheduler::workerLoop(const size_t workerIndex)
+    {
+        currentWorkerIndex = static_cast<int>(workerIndex);
+
+        while (true)
+        {
+            Task task;
+            if (tryPop(workerIndex, task))
+            {
+                task();
+                continue;
+            }
+
+            std::unique_lock lock{ sleepMutex };
+            wakeUp.wait(lock, [this] { return stopping || queuedTasks > 0; });
+            if (stopping)
+            {
+                return;
+            }
+        }
+    }
+
+    Scheduler& defaultScheduler()
+    {
+        static Scheduler instance{ std::thread::hardware_concurrency() };
+        return instance;
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include "cancellation.h"
+#include "profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace scheduler
+{
+    using Task = std::function<void()>;
+
+    // Work-stealing scheduler: each worker owns a deque of tasks, pushing and popping at the back of its own
+    // deque, while idle workers steal from the front of the others.
+    class Scheduler
+    {
+    public:
+        explicit Scheduler(size_t workerCount);
+        ~Scheduler();
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        void submit(Task task);
+        bool tryRunOne();
+
+        [[nodiscard]] size_t workerCount() const { return workers.size(); }
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex{};
+            std::deque<Task> tasks{};
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers{};
+        std::vector<std::thread> threads{};
+
+        std::mutex sleepMutex{};
+        std::condition_variable wakeUp{};
+        std::atomic<size_t> queuedTasks{};
+        std::atomic<size_t> nextExternalWorker{};
+        bool stopping{};
+
+        bool tryPop(size_t workerIndex, Task& task);
+        void workerLoop(size_t workerIndex);
+    };
+
+    // Scheduler shared by all solvers, started on first use with one worker per hardware thread.
+    Scheduler& defaultScheduler();
+
+    // Group of forked tasks that can be joined. Joining runs queued tasks on the calling thread while
+    // waiting, so tasks can fork and join nested groups without starving the workers.
+    // Tasks run under the cancellation token & profiler tag of the thread that forked them, and the first
+    // exception thrown by any of them is rethrown from join().
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(Scheduler& s = defaultScheduler()) : scheduler{ s } {}
+        ~TaskGroup() { wait(); }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void fork(Task task)
+        {
+            ++pending;
+            scheduler.submit([this, task = std::move(task), token = cancellation::current(), tag = profiler::currentTag()]
+            {
+                try
+                {
+                    const cancellation::Scope scope{ token };
+                    const profiler::DayScope dayScope{ tag };
+                    task();
+                }
+                catch (...)
+                {
+                    std::lock_guard lock{ exceptionMutex };
+                    if (!exception)
+                    {
+                        exception = std::current_exception();
+                    }
+                }
+
+                --pending;
+            });
+        }
+
+        void join()
+        {
+            wait();
+
+            std::lock_guard lock{ exceptionMutex };
+            if (exception)
+            {
+                std::rethrow_exception(std::exchange(exception, nullptr));
+            }
+        }
+
+    private:
+        Scheduler& scheduler;
+        std::atomic<size_t> pending{};
+        std::mutex exceptionMutex{};
+        std::exception_ptr exception{};
+
+        void wait()
+        {
+            while (pending > 0)
+            {
+                if (!scheduler.tryRunOne())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+
+    // Calls body(i) for every i in [begin, end), recursively splitting the range in halves down to grainSize.
+    template <typename Body>
+    void parallel_for(const size_t begin, const size_t end, const Body& body, const size_t grainSize = 1)
+    {
+        if (end - begin <= std::max<size_t>(grainSize, 1))
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                body(i);
+            }
+
+            return;
+        }
+
+        const size_t middle{ begin + (end - begin) / 2 };
+        TaskGroup group{};
+        group.fork([&] { parallel_for(middle, end, body, grainSize); });
+        parallel_for(begin, middle, body, grainSize);
+        group.join();
+    }
+
+    // Maps every i in [begin, end) in parallel, then folds the results in index order. The fold order doesn't
+    // depend on how tasks got scheduled, so the result is reproducible even for non-associative combines.
+    template <typename T, typename Map, typename Combine>
+    T parallel_reduce(const size_t begin, const size_t end, T identity, const Map& map, const Combine& combine, const size_t grainSize = 1)
+    {
+        std::vector<T> results(end - begin, identity);
+        parallel_for(begin, end, [&](const size_t i) { results[i - begin] = map(i); }, grainSize);
+
+        T result{ identity };
+        for (const auto& r : results)
+        {
+            result = combine(result, r);
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,261 @@
+#include "server.h"
+#include "solvers.h"
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace server
+{
+#ifdef _WIN32
+    using Socket = SOCKET;
+    constexpr Socket invalidSocket{ INVALID_SOCKET };
+    void closeSocket(const Socket socket) { closesocket(socket); }
+    constexpr int sendFlags{};
+#else
+    using Socket = int;
+    constexpr Socket invalidSocket{ -1 };
+    void closeSocket(const Socket socket) { close(socket); }
+
+    // A client disconnecting halfway through a response must not raise SIGPIPE & kill the daemon.
+#ifdef MSG_NOSIGNAL
+    constexpr int sendFlags{ MSG_NOSIGNAL };
+#else
+    constexpr int sendFlags{};
+#endif
+#endif
+
+    // Wraps a connected client socket to read requests line by line (or a fixed nr of bytes for inline
+    // inputs) and to write back responses.
+    struct Connection
+    {
+        Socket socket{};
+        std::string buffer{};
+
+        bool fillBuffer()
+        {
+            char chunk[4096];
+            const auto received{ recv(socket, chunk, sizeof(chunk), 0) };
+            if (received <= 0)
+            {
+                return false;
+            }
+
+            buffer.append(chunk, static_cast<size_t>(received));
+            return true;
+        }
+
+        bool readLine(std::string& line)
+        {
+            size_t newLinePos;
+            while ((newLinePos = buffer.find('\n')) == std::string::npos)
+            {
+                if (!fillBuffer())
+                {
+                    return false;
+                }
+            }
+
+            line = buffer.substr(0, newLinePos);
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+
+            buffer.erase(0, newLinePos + 1);
+            return true;
+        }
+
+        bool readBytes(const size_t count, std::string& bytes)
+        {
+            while (buffer.size() < count)
+            {
+                if (!fillBuffer())
+                {
+                    return false;
+                }
+            }
+
+            bytes = buffer.substr(0, count);
+            buffer.erase(0, count);
+            return true;
+        }
+
+        void write(const std::string& response) const
+        {
+            size_t sent{};
+            while (sent < response.size())
+            {
+                const auto result{ send(socket, response.data() + sent, static_cast<int>(response.size() - sent), sendFlags) };
+                if (result <= 0)
+                {
+                    return;
+                }
+
+                sent += static_cast<size_t>(result);
+            }
+        }
+    };
+
+    // Answers computed for input files, invalidated once the last write time of the file changes.
+    struct CacheEntry
+    {
+        std::filesystem::file_time_type lastWriteTime{};
+        long long answer{};
+    };
+
+    std::map<std::tuple<int, int, std::string>, CacheEntry> answerCache{};
+
+    std::string formatAnswer(const solvers::SolveResult& result, const bool cached)
+    {
+        std::stringstream response;
+        if (result.timedOut)
+        {
+            response << "timeout time_us " << result.microseconds << " iterations " << result.iterations << '\n';
+            return response.str();
+        }
+
+        response << "answer " << result.answer << " time_us " << result.microseconds << (cached ? " cached" : "") << '\n';
+        return response.str();
+    }
+
+    // Handles a single request of the form "day N part P input <path>" or "day N part P input inline <length>",
+    // where the latter is followed directly by length bytes of puzzle input.
+    std::string handleRequest(Connection& connection, const std::string& request)
+    {
+        std::stringstream requestStream;
+        requestStream << request;
+        std::string dayKeyword, partKeyword, inputKeyword, source;
+        int day{}, part{};
+        requestStream >> dayKeyword >> day >> partKeyword >> part >> inputKeyword >> source;
+
+        if (requestStream.fail() || dayKeyword != "day" || partKeyword != "part" || inputKeyword != "input")
+        {
+            return "error expected: day N part P input <path|inline length>\n";
+        }
+
+        if (!solvers::getSolver(day, part))
+        {
+            return "error no solver for day " + std::to_string(day) + " part " + std::to_string(part) + '\n';
+        }
+
+        if (source == "inline")
+        {
+            size_t length{};
+            requestStream >> length;
+            std::string input;
+            if (requestStream.fail() || !connection.readBytes(length, input))
+            {
+                return "error missing inline input\n";
+            }
+
+            std::istringstream inputStream{ input };
+            return formatAnswer(solvers::runTimed(day, part, inputStream), false);
+        }
+
+        std::error_code error;
+        const auto lastWriteTime{ std::filesystem::last_write_time(source, error) };
+        std::ifstream file{ source };
+        if (error || !file)
+        {
+            return "error could not open " + source + '\n';
+        }
+
+        const auto key{ std::make_tuple(day, part, source) };
+        const auto cached{ answerCache.find(key) };
+        if (cached != answerCache.end() && cached->second.lastWriteTime == lastWriteTime)
+        {
+            return formatAnswer({ cached->second.answer, 0 }, true);
+        }
+
+        const solvers::SolveResult result{ solvers::runTimed(day, part, file) };
+        if (!result.timedOut)
+        {
+            answerCache[key] = { lastWriteTime, result.answer };
+        }
+
+        return formatAnswer(result, false);
+    }
+
+    // Handles a request, turning anything a solver throws (malformed input, a --verify mismatch, ...) into an
+    // error response, so a single bad request can't take down the daemon.
+    std::string respond(Connection& connection, const std::string& request)
+    {
+        try
+        {
+            return handleRequest(connection, request);
+        }
+        catch (const std::exception& e)
+        {
+            std::string message{ e.what() };
+            std::ranges::replace(message, '\n', ' ');
+            return "error " + message + '\n';
+        }
+    }
+
+    // Runs a daemon listening on a unix domain socket at socketPath, answering solve requests until killed.
+    // Each connection can send any number of requests, each answered by a single line.
+    void run_server(const std::string& socketPath)
+    {
+#ifdef _WIN32
+        WSADATA wsaData;
+        WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+
+        const Socket listener{ socket(AF_UNIX, SOCK_STREAM, 0) };
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (listener == invalidSocket || socketPath.size() >= sizeof(address.sun_path))
+        {
+            std::cout << "Could not create socket at " << socketPath << '\n';
+            return;
+        }
+
+        socketPath.copy(address.sun_path, socketPath.size());
+        std::filesystem::remove(socketPath);
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 16) != 0)
+        {
+            std::cout << "Could not listen on " << socketPath << '\n';
+            closeSocket(listener);
+            return;
+        }
+
+        std::cout << "Listening on " << socketPath << '\n';
+
+        while (true)
+        {
+            Connection connection{ accept(listener, nullptr, nullptr) };
+            if (connection.socket == invalidSocket)
+            {
+                continue;
+            }
+
+            std::string request;
+            while (connection.readLine(request))
+            {
+                if (!request.empty())
+                {
+                    connection.write(respond(connection, request));
+                }
+            }
+
+            closeSocket(connection.socket);
+        }
+    }
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include <string>
+
+namespace server
+{
+    void run_server(const std::string& socketPath);
+}
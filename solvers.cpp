@@ -0,0 +1,414 @@
+#include "solvers.h"
+#include "cancellation.h"
+#include "day01.h"
+#include "day02.h"
+#include "day03.h"
+#include "day04.h"
+#include "day05.h"
+#include "day06.h"
+#include "day07.h"
+#include "day08.h"
+#include "day09.h"
+#include "day10.h"
+#include "day11.h"
+#include "day12.h"
+#include "day13.h"
+#include "day14.h"
+#include "day15.h"
+#include "day16.h"
+#include "day17.h"
+#include "day18.h"
+#include "day19.h"
+#include "day20.h"
+#include "day21.h"
+#include "day22.h"
+#include "day23.h"
+#include "day24.h"
+#include "day25.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace solvers
+{
+    // Solvers for both parts of each day, indexed by day - 1. Days that need to know whether they are run on
+    // the example input are always given the real input settings here.
+    const std::array<std::array<Solver, 2>, 25> allSolvers{ {
+        { day01::solvePart1, day01::solvePart2 },
+        { day02::solvePart1, day02::solvePart2 },
+        { day03::solvePart1, day03::solvePart2 },
+        { day04::solvePart1, day04::solvePart2 },
+        { day05::solvePart1, day05::solvePart2 },
+        { day06::solvePart1, day06::solvePart2 },
+        { day07::solvePart1, day07::solvePart2 },
+        { day08::solvePart1, day08::altSolvePart2 },
+        { day09::solvePart1, day09::solvePart2 },
+        { day10::solvePart1, day10::solvePart2 },
+        { day11::solvePart1, day11::solvePart2 },
+        { day12::solvePart1, day12::solvePart2 },
+        { day13::solvePart1, day13::solvePart2 },
+        { day14::solvePart1, day14::solvePart2 },
+        { day15::solvePart1, day15::solvePart2 },
+        { day16::solvePart1, day16::solvePart2 },
+        { day17::solvePart1, day17::solvePart2 },
+        { day18::solvePart1, day18::solvePart2 },
+        { day19::solvePart1, day19::solvePart2 },
+        { day20::solvePart1, day20::solvePart2 },
+        {
+            [](std::istream& file) { return day21::solvePart1(file, false); },
+            [](std::istream& file) { return day21::solvePart2(file, false); }
+        },
+        { day22::solvePart1, day22::solvePart2 },
+        { day23::solvePart1, day23::solvePart2 },
+        { [](std::istream& file) { return day24::solvePart1(file, false); }, day24::solvePart2 },
+        { day25::solvePart1, day25::solvePart2 }
+    } };
+
+    struct AlternativeEngine
+    {
+        int day{};
+        int part{};
+        Engine engine{};
+    };
+
+    // Engines next to the reference solvers above, that the engine config can select per input size.
+    const std::vector<AlternativeEngine> alternativeEngines{
+        { 1, 1, { "simd", day01::solvePart1Simd } },
+        { 1, 2, { "automaton", day01::solvePart2Automaton } },
+        { 2, 1, { "fused", day02::solvePart1Fused } },
+        { 2, 1, { "limit-index", day02::solvePart1Indexed } },
+        { 2, 1, { "columnar", day02::solvePart1Columnar } },
+        { 2, 2, { "fused", day02::solvePart2Fused } },
+        { 2, 2, { "columnar", day02::solvePart2Columnar } },
+        { 3, 1, { "single-pass", day03::solvePart1SinglePass } },
+        { 3, 1, { "label-index", day03::solvePart1Labelled } },
+        { 3, 1, { "banded", day03::solvePart1Banded } },
+        { 3, 1, { "banded-narrow", day03::solvePart1BandedNarrow, true } },
+        { 3, 2, { "single-pass", day03::solvePart2SinglePass } },
+        { 3, 2, { "label-index", day03::solvePart2Labelled } },
+        { 3, 2, { "banded", day03::solvePart2Banded } },
+        { 3, 2, { "banded-narrow", day03::solvePart2BandedNarrow, true } },
+        { 4, 1, { "bitmask", day04::solvePart1Bitmask } },
+        { 4, 1, { "fixed-columns", day04::solvePart1FixedColumns } },
+        { 4, 1, { "streaming", day04::solvePart1Streaming } },
+        { 4, 2, { "bitmask", day04::solvePart2Bitmask } },
+        { 4, 2, { "fixed-columns", day04::solvePart2FixedColumns } },
+        { 4, 2, { "streaming", day04::solvePart2Streaming } },
+        { 5, 1, { "composed", day05::solvePart1Composed } },
+        { 5, 1, { "batch", day05::solvePart1Batch } },
+        { 5, 2, { "composed", day05::solvePart2Composed } },
+        { 5, 2, { "reverse-index", day05::solvePart2ReverseIndex } },
+        { 8, 2, { "brute-force", day08::solvePart2, true } }
+    };
+
+    // All engines of both parts of each day, indexed by day - 1, with the reference solver first.
+    const std::array<std::array<std::vector<Engine>, 2>, 25> allEngines{ []
+    {
+        std::array<std::array<std::vector<Engine>, 2>, 25> engines{};
+        for (size_t day = 0; day < engines.size(); day++)
+        {
+            for (size_t part = 0; part < 2; part++)
+            {
+                engines[day][part].push_back(Engine{ "reference", allSolvers[day][part] });
+            }
+        }
+
+        for (const auto& [day, part, engine] : alternativeEngines)
+        {
+            engines[static_cast<size_t>(day - 1)][static_cast<size_t>(part - 1)].push_back(engine);
+        }
+
+        return engines;
+    }() };
+
+    // Engine choices per day & part by ascending max input size, set from the engine config.
+    std::array<std::array<std::vector<EngineChoice>, 2>, 25> engineChoices{};
+
+    bool verifyEngines{};
+
+    bool isValid(const int day, const int part)
+    {
+        return day >= 1 && day <= 25 && part >= 1 && part <= 2;
+    }
+
+    // Size of the rest of the input, or 0 if the stream can't tell.
+    size_t remainingInputSize(std::istream& input)
+    {
+        const auto start{ input.tellg() };
+        if (start < 0)
+        {
+            return 0;
+        }
+
+        input.seekg(0, std::ios::end);
+        const auto end{ input.tellg() };
+        input.seekg(start);
+        return end > start ? static_cast<size_t>(end - start) : 0;
+    }
+
+    // Picks the engine chosen for the given input size, falling back to the reference engine.
+    const Engine& selectEngine(const int day, const int part, const size_t inputSize)
+    {
+        const auto& engines{ getEngines(day, part) };
+        for (const auto& [maxInputSize, engineName] : engineChoices[static_cast<size_t>(day - 1)][static_cast<size_t>(part - 1)])
+        {
+            if (inputSize > maxInputSize)
+            {
+                continue;
+            }
+
+            const auto engine{ std::ranges::find(engines, engineName, &Engine::name) };
+            if (engine != engines.end())
+            {
+                return *engine;
+            }
+        }
+
+        return engines.front();
+    }
+
+    // Solvers dispatching to the engine chosen for the size of their input, indexed by day - 1.
+    const std::array<std::array<Solver, 2>, 25> selectedSolvers{ []
+    {
+        std::array<std::array<Solver, 2>, 25> solvers{};
+        for (int day = 1; day <= 25; day++)
+        {
+            for (int part = 1; part <= 2; part++)
+            {
+                solvers[static_cast<size_t>(day - 1)][static_cast<size_t>(part - 1)] = [day, part](std::istream& input)
+                {
+                    return selectEngine(day, part, remainingInputSize(input)).solve(input);
+                };
+            }
+        }
+
+        return solvers;
+    }() };
+
+    // Returns the solver for the given day (1-25) and part (1-2), or nullptr if there is no such solver.
+    const Solver* getSolver(const int day, const int part)
+    {
+        if (!isValid(day, part))
+        {
+            return nullptr;
+        }
+
+        return &selectedSolvers[static_cast<size_t>(day - 1)][static_cast<size_t>(part - 1)];
+    }
+
+    // Returns all engines for the given day (1-25) and part (1-2), the reference engine first.
+    const std::vector<Engine>& getEngines(const int day, const int part)
+    {
+        return allEngines[static_cast<size_t>(day - 1)][static_cast<size_t>(part - 1)];
+    }
+
+    void setEngineChoices(const int day, const int part, const std::vector<EngineChoice>& choices)
+    {
+        if (isValid(day, part))
+        {
+            auto& dayChoices{ engineChoices[static_cast<size_t>(day - 1)][static_cast<size_t>(part - 1)] };
+            dayChoices = choices;
+            std::ranges::sort(dayChoices, {}, &EngineChoice::maxInputSize);
+        }
+    }
+
+    // Reads the engine choices from a config file with lines of "day part maxInputSize engine",
+    // where maxInputSize is a number of bytes or '*' for any size. Lines starting with '#' are ignored.
+    bool loadEngineConfig(const std::string& fileName)
+    {
+        std::ifstream file{ fileName };
+        if (!file)
+        {
+            return false;
+        }
+
+        std::array<std::array<std::vector<EngineChoice>, 2>, 25> choices{};
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line.starts_with('#'))
+            {
+                continue;
+            }
+
+            std::stringstream lineStream{ line };
+            int day{}, part{};
+            std::string maxInputSize, engine;
+            lineStream >> day >> part >> maxInputSize >> engine;
+            if (lineStream.fail() || !isValid(day, part))
+            {
+                std::cout << "Ignoring invalid engine config line: " << line << '\n';
+                continue;
+            }
+
+            choices[static_cast<size_t>(day - 1)][static_cast<size_t>(part - 1)].push_back(
+                EngineChoice{ maxInputSize == "*" ? std::numeric_limits<size_t>::max() : std::stoull(maxInputSize), engine });
+        }
+
+        for (int day = 1; day <= 25; day++)
+        {
+            for (int part = 1; part <= 2; part++)
+            {
+                setEngineChoices(day, part, choices[static_cast<size_t>(day - 1)][static_cast<size_t>(part - 1)]);
+            }
+        }
+
+        return true;
+    }
+
+    bool saveEngineConfig(const std::string& fileName)
+    {
+        std::ofstream file{ fileName };
+        if (!file)
+        {
+            return false;
+        }
+
+        file << "# day part maxInputSize engine\n";
+        for (int day = 1; day <= 25; day++)
+        {
+            for (int part = 1; part <= 2; part++)
+            {
+                for (const auto& [maxInputSize, engine] : engineChoices[static_cast<size_t>(day - 1)][static_cast<size_t>(part - 1)])
+                {
+                    file << day << ' ' << part << ' ';
+                    if (maxInputSize == std::numeric_limits<size_t>::max())
+                    {
+                        file << '*';
+                    }
+                    else
+                    {
+                        file << maxInputSize;
+                    }
+
+                    file << ' ' << engine << '\n';
+                }
+            }
+        }
+
+        return static_cast<bool>(file);
+    }
+
+    // When set, every solve also runs all other engines of the part & fails if their answers differ.
+    void setVerify(const bool verify)
+    {
+        verifyEngines = verify;
+    }
+
+    // Time budget per day, indexed by day - 1. Days without a budget may run for as long as they need.
+    std::array<std::optional<std::chrono::milliseconds>, 25> timeBudgets{};
+
+    // Sets the time budget for the given day (1-25), after which its solvers get cancelled.
+    void setTimeBudget(const int day, const std::chrono::milliseconds budget)
+    {
+        if (day >= 1 && day <= 25)
+        {
+            timeBudgets[static_cast<size_t>(day - 1)] = budget;
+        }
+    }
+
+    // Sets the same time budget for all days.
+    void setTimeBudget(const std::chrono::milliseconds budget)
+    {
+        timeBudgets.fill(budget);
+    }
+
+    // Runs the solver for the given day on the given input, timing how long it takes.
+    // If the day has a time budget the solver gets cancelled once it runs past it.
+    SolveResult runEngine(const int day, const Solver& solver, std::istream& input)
+    {
+        const auto start{ std::chrono::steady_clock::now() };
+        const auto microsecondsSinceStart{ [&start]
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        } };
+
+        const auto& budget{ timeBudgets[static_cast<size_t>(day - 1)] };
+        if (!budget)
+        {
+            const long long answer{ solver(input) };
+            return { answer, microsecondsSinceStart() };
+        }
+
+        cancellation::Token token{ *budget };
+        const cancellation::Scope scope{ &token };
+        try
+        {
+            const long long answer{ solver(input) };
+            return { answer, microsecondsSinceStart() };
+        }
+        catch (const cancellation::TimedOut& timedOut)
+        {
+            return { 0, microsecondsSinceStart(), true, timedOut.iterationsDone };
+        }
+    }
+
+    // Solves the given day & part with the engine chosen for the input. When verifying, all engines are run
+    // & a std::runtime_error is thrown if any of them disagrees with the reference engine or fails. Engines
+    // running out of their time budget, & ones only meant for small inputs unless chosen, are left out of the
+    // comparison.
+    SolveResult runTimed(const int day, const int part, std::istream& input)
+    {
+        if (!verifyEngines)
+        {
+            return runEngine(day, *getSolver(day, part), input);
+        }
+
+        const std::string contents{ std::istreambuf_iterator<char>{ input }, std::istreambuf_iterator<char>{} };
+        const Engine& selected{ selectEngine(day, part, contents.size()) };
+        const auto& engines{ getEngines(day, part) };
+
+        SolveResult selectedResult{};
+        SolveResult referenceResult{};
+        for (const auto& engine : engines)
+        {
+            if (engine.smallInputsOnly && &engine != &selected)
+            {
+                continue;
+            }
+
+            std::istringstream engineInput{ contents };
+            SolveResult result{};
+            try
+            {
+                result = runEngine(day, engine.solve, engineInput);
+            }
+            catch (const std::exception& e)
+            {
+                if (&engine == &engines.front())
+                {
+                    throw;
+                }
+
+                throw std::runtime_error{ "day " + std::to_string(day) + " part " + std::to_string(part) + " engine " + engine.name
+                    + " failed: " + e.what() };
+            }
+
+            if (&engine == &engines.front())
+            {
+                referenceResult = result;
+            }
+            else if (!result.timedOut && !referenceResult.timedOut && result.answer != referenceResult.answer)
+            {
+                throw std::runtime_error{ "day " + std::to_string(day) + " part " + std::to_string(part) + " engine " + engine.name
+                    + " answered " + std::to_string(result.answer) + " but reference answered " + std::to_string(referenceResult.answer) };
+            }
+
+            if (&engine == &selected)
+            {
+                selectedResult = result;
+            }
+        }
+
+        return selectedResult;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <chrono>
+#include <istream>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace solvers
+{
+    using Solver = std::function<long long(std::istream&)>;
+
+    // A named implementation of one part of a day. The first engine of each part is the reference one.
+    struct Engine
+    {
+        std::string name{};
+        Solver solve{};
+
+        // Only practical on small inputs, like a brute force. Fuzzed, but left out of --verify & --autotune.
+        bool smallInputsOnly{};
+    };
+
+    // Engine to use for inputs of up to maxInputSize bytes.
+    struct EngineChoice
+    {
+        size_t maxInputSize{};
+        std::string engine{};
+    };
+
+    struct SolveResult
+    {
+        long long answer{};
+        long long microseconds{};
+
+        // Set when the solver ran out of its time budget, the answer is meaningless then.
+        bool timedOut{};
+        long long iterations{};
+    };
+
+    const Solver* getSolver(int day, int part);
+    const std::vector<Engine>& getEngines(int day, int part);
+    void setEngineChoices(int day, int part, const std::vector<EngineChoice>& choices);
+    bool loadEngineConfig(const std::string& fileName);
+    bool saveEngineConfig(const std::string& fileName);
+    void setVerify(bool verify);
+    void setTimeBudget(int day, std::chrono::milliseconds budget);
+    void setTimeBudget(std::chrono::milliseconds budget);
+    SolveResult runEngine(int day, const Solver& solver, std::istream& input);
+    SolveResult runTimed(int day, int part, std::istream& input);
+}